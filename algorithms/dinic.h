@@ -0,0 +1,85 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+
+#include "../common/counters.h"
+#include "../common/phase_times.h"
+#include "../common/progress.h"
+#include "../common/residual_graph.h"
+
+template<class Cap>
+struct Dinic {
+	const int n, s, t;
+	ResidualGraph<Cap> adj;
+	int *label, *que, *iter;
+	OperationCounts counts;
+	PhaseTimes times;
+	Progress progress;
+
+	Dinic(int _n, int _s, int _t, Arena& arena) : n(_n), s(_s), t(_t), adj(n, arena) {
+		label = arena.allocate<int>(n, Use::Vertices);
+		que = arena.allocate<int>(n, Use::Queues);
+		iter = arena.allocate<int>(n, Use::Vertices);
+	}
+
+	void addEdge(int from, int to, Cap cap) {
+		if (from != to && cap >= 1) {
+			adj.addEdge(from, to, cap);
+		}
+	}
+
+	long long flow() {
+		long long ans = 0;
+		adj.build();
+		while (bfs()) {
+			ScopedPhase phase(times, times.phase("dfs"));
+			std::copy(adj.first, adj.first + n, iter);
+			ans += dfs(t, std::numeric_limits<long long>::max());
+			progress.step(ans);
+		}
+		return ans;
+	}
+
+	bool bfs() {
+		ScopedPhase phase(times, times.phase("bfs"));
+		counts.phases += 1;
+		std::fill(label, label + n, n);
+		label[s] = 0;
+		que[0] = s;
+		int queBegin = 0;
+		int queEnd = 1;
+		while (queBegin < queEnd) {
+			int v = que[queBegin++];
+			for (const Arc<Cap>& e : adj.out(v)) {
+				counts.arcs_scanned += 1;
+				if (!e.cap || label[e.to] < n) continue;
+				label[e.to] = label[v] + 1;
+				if (e.to == t) return true;
+				que[queEnd++] = e.to;
+			}
+		}
+		return false;
+	}
+
+	long long dfs(int v, long long up) {
+		if (v == s) {
+			counts.augmenting_paths += 1;
+			return up;
+		}
+		long long res = 0;
+		for (; iter[v] < adj.first[v + 1]; ++iter[v]) {
+			counts.arcs_scanned += 1;
+			Arc<Cap>& e = adj.arcs[iter[v]];
+			Arc<Cap>& r = adj.arcs[e.rev];
+			if (!r.cap || label[v] <= label[e.to]) continue;
+			Cap d = dfs(e.to, std::min(1LL * r.cap, up - res));
+			e.cap += d;
+			r.cap -= d;
+			res += d;
+			if (res == up) return res;
+		}
+		label[v] = n;
+		return res;
+	}
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+
+#include "../common/counters.h"
+#include "../common/phase_times.h"
+#include "../common/progress.h"
+#include "../common/residual_graph.h"
+
+template<class Cap>
+struct EdmondsKarp {
+	const int n, s, t;
+	ResidualGraph<Cap> adj;
+	int *que, *parent;
+	Cap* path_cap;
+	OperationCounts counts;
+	PhaseTimes times;
+	Progress progress;
+
+	EdmondsKarp(int _n, int _s, int _t, Arena& arena) : n(_n), s(_s), t(_t), adj(n, arena) {
+		que = arena.allocate<int>(n, Use::Queues);
+		parent = arena.allocate<int>(n, Use::Vertices);
+		path_cap = arena.allocate<Cap>(n, Use::Vertices);
+	}
+
+	void addEdge(int from, int to, Cap cap) {
+		if (from != to && cap >= 1) {
+			adj.addEdge(from, to, cap);
+		}
+	}
+
+	long long flow() {
+		long long ans = 0;
+		adj.build();
+		while (bfs()) {
+			counts.augmenting_paths += 1;
+			ans += path_cap[t];
+			progress.step(ans);
+			int v = t;
+			while (v != s) {
+				Arc<Cap>& e = adj.arcs[parent[v]];
+				e.cap += path_cap[t];
+				adj.arcs[e.rev].cap -= path_cap[t];
+				v = e.to;
+			}
+		}
+		return ans;
+	}
+
+	bool bfs() {
+		counts.phases += 1;
+		std::fill(parent, parent + n, -1);
+		parent[s] = -2;
+		path_cap[s] = std::numeric_limits<Cap>::max();
+		que[0] = s;
+		int queBegin = 0;
+		int queEnd = 1;
+		while (queBegin < queEnd) {
+			int v = que[queBegin++];
+			for (const Arc<Cap>& e : adj.out(v)) {
+				counts.arcs_scanned += 1;
+				if (!e.cap || parent[e.to] != -1) continue;
+				parent[e.to] = e.rev;
+				path_cap[e.to] = std::min(path_cap[v], e.cap);
+				if (e.to == t) return true;
+				que[queEnd++] = e.to;
+			}
+		}
+		return false;
+	}
+};
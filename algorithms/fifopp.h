@@ -0,0 +1,10 @@
+#pragma once
+
+#include "push_relabel.h"
+
+// FIFO Preflow Push
+template<class Cap>
+using FIFOPP = PushRelabel<Cap, FIFO<true>, NoGlobalRelabel, NoGaps, TwoPhase>;
+
+template<class Cap>
+using FIFOPPValueOnly = PushRelabel<Cap, FIFO<true>, NoGlobalRelabel, NoGaps, ValueOnly>;
@@ -0,0 +1,6 @@
+#include "../common/solver_main.h"
+#include "fifopp_heuristic.h"
+
+int main(int argc, char* argv[]) {
+	return runSolver<FIFOPPHeuristic>(argc, argv);
+}
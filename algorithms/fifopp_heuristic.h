@@ -0,0 +1,7 @@
+#pragma once
+
+#include "push_relabel.h"
+
+// FIFO Preflow Push with Global Relabeling and Gap Heuristics
+template<class Cap>
+using FIFOPPHeuristic = PushRelabel<Cap, FIFO<>, RelabelCount<5>, GapLists, ValueOnly>;
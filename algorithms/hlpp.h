@@ -0,0 +1,10 @@
+#pragma once
+
+#include "push_relabel.h"
+
+// Highest-Label Preflow Push
+template<class Cap>
+using HLPP = PushRelabel<Cap, HighestLabel, NoGlobalRelabel, NoGaps, TwoPhase>;
+
+template<class Cap>
+using HLPPValueOnly = PushRelabel<Cap, HighestLabel, NoGlobalRelabel, NoGaps, ValueOnly>;
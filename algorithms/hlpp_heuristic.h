@@ -0,0 +1,7 @@
+#pragma once
+
+#include "push_relabel.h"
+
+// Highest-Label Preflow Push with Global Relabeling and Gap Heuristics
+template<class Cap>
+using HLPPHeuristic = PushRelabel<Cap, HighestLabel, RelabelCount<5>, GapLists, ValueOnly>;
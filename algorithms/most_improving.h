@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+
+#include "../common/counters.h"
+#include "../common/phase_times.h"
+#include "../common/progress.h"
+#include "../common/residual_graph.h"
+
+template<class Cap>
+struct MostImprovingAugmentingPaths {
+	const int n, s, t;
+	ResidualGraph<Cap> adj;
+	Arena& arena;
+	int* parent;
+	Cap* path_cap;
+	std::pair<Cap, int>* heap;
+	OperationCounts counts;
+	PhaseTimes times;
+	Progress progress;
+
+	MostImprovingAugmentingPaths(int _n, int _s, int _t, Arena& _arena) : n(_n), s(_s), t(_t),
+		adj(n, _arena), arena(_arena) {
+		parent = arena.allocate<int>(n, Use::Vertices);
+		path_cap = arena.allocate<Cap>(n, Use::Vertices);
+	}
+
+	void addEdge(int from, int to, Cap cap) {
+		if (from != to && cap >= 1) {
+			adj.addEdge(from, to, cap);
+		}
+	}
+
+	long long flow() {
+		long long ans = 0;
+		adj.build();
+		// every arc is relaxed at most once per search
+		heap = arena.allocate<std::pair<Cap, int>>(adj.num_arcs + 1, Use::Queues);
+		while (dijkstra()) {
+			counts.augmenting_paths += 1;
+			ans += path_cap[t];
+			progress.step(ans);
+			int v = t;
+			while (v != s) {
+				Arc<Cap>& e = adj.arcs[parent[v]];
+				e.cap += path_cap[t];
+				adj.arcs[e.rev].cap -= path_cap[t];
+				v = e.to;
+			}
+		}
+		return ans;
+	}
+
+	bool dijkstra() {
+		counts.phases += 1;
+		std::fill(path_cap, path_cap + n, 0);
+		parent[s] = -2;
+		path_cap[s] = std::numeric_limits<Cap>::max();
+		int heap_size = 0;
+		heap[heap_size++] = {path_cap[s], s};
+		counts.heap_operations += 1;
+		while (heap_size > 0) {
+			std::pop_heap(heap, heap + heap_size);
+			counts.heap_operations += 1;
+			auto [flow, v] = heap[--heap_size];
+			if (v == t) return true;
+			if (flow < path_cap[v]) continue;
+			for (const Arc<Cap>& e : adj.out(v)) {
+				counts.arcs_scanned += 1;
+				if (std::min(flow, e.cap) > path_cap[e.to]) {
+					path_cap[e.to] = std::min(flow, e.cap);
+					parent[e.to] = e.rev;
+					heap[heap_size++] = {path_cap[e.to], e.to};
+					std::push_heap(heap, heap + heap_size);
+					counts.heap_operations += 1;
+				}
+			}
+		}
+		return false;
+	}
+};
+ 
@@ -0,0 +1,9 @@
+#include "../common/solver_main.h"
+#include "parallel_pr.h"
+
+int main(int argc, char* argv[]) {
+	const char* threads = getOption(argc, argv, "threads");
+	return runSolver<ParallelPushRelabel>(argc, argv, [&](auto& g) {
+		if (threads) g.threads = std::atoi(threads);
+	});
+}
@@ -0,0 +1,332 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+
+#include "../common/counters.h"
+#include "../common/phase_times.h"
+#include "../common/progress.h"
+#include "../common/residual_graph.h"
+#include "../common/thread_pool.h"
+
+// Synchronous parallel push-relabel (Baumstark, Blelloch and Shun) with
+// global relabeling and gap heuristics.
+// Every round discharges all active vertices concurrently against the
+// heights of the previous round. Of two active neighbors only the winner
+// (see wins) may push along the edge between them, so every arc has one
+// writer per round; the increase of a reverse arc is applied after the
+// round, so no vertex reads an arc that another one writes. Pushed excess
+// is added atomically and takes effect in the next round.
+template<class Cap>
+struct ParallelPushRelabel {
+	struct alignas(64) ThreadState {
+		// the last vertices this thread discovered and pushes it made, not
+		// yet in next and pushes
+		int* discovered;
+		std::pair<int, Cap>* pushes;
+		int num_discovered = 0, num_pushes = 0;
+		long long work = 0;
+		int max_height = 0;
+		OperationCounts counts;
+	};
+
+	const int n, s, t;
+	Arena& arena;
+	ResidualGraph<Cap> adj;
+	int *height, *new_height;
+	long long* excess;
+	std::atomic<long long>* added_excess;
+	std::atomic<char>* discovered;
+	// vertices other than s and t per height below n
+	std::atomic<int>* count;
+	// the working set and the vertices discovered in this round, each
+	// vertex at most once
+	int *working, *next;
+	int num_working;
+	std::atomic<int> num_next;
+	// reverse arc and amount of every push of this round, at most one per
+	// arc
+	std::pair<int, Cap>* pushes;
+	std::atomic<int> num_pushes;
+	// heights that ran empty in this round
+	int* gaps;
+	std::atomic<int> num_gaps;
+	ThreadState* state;
+	std::unique_ptr<ThreadPool> pool;
+	// no vertex other than s has a height in (max_height, n)
+	int max_height;
+	long long work;
+	int threads; // taken from the hardware unless set
+	OperationCounts counts;
+	PhaseTimes times;
+	Progress progress;
+
+	// Loops over fewer vertices run on one thread (see thread_pool.h).
+	static const int GRAIN = 256;
+	// Vertices or pushes a thread collects before it moves them to the
+	// shared array.
+	static const int BATCH = 256;
+
+	ParallelPushRelabel(int _n, int _s, int _t, Arena& _arena) : n(_n), s(_s), t(_t), arena(_arena), adj(n, arena),
+		height(arena.allocate<int>(n, Use::Vertices)), new_height(arena.allocate<int>(n, Use::Vertices)),
+		excess(arena.allocate<long long>(n, Use::Vertices)), added_excess(arena.allocate<std::atomic<long long>>(n, Use::Vertices)),
+		discovered(arena.allocate<std::atomic<char>>(n, Use::Vertices)), count(arena.allocate<std::atomic<int>>(n, Use::Queues)),
+		working(arena.allocate<int>(n, Use::Queues)), next(arena.allocate<int>(n, Use::Queues)), num_working(0), num_next(0),
+		pushes(nullptr), num_pushes(0), gaps(arena.allocate<int>(n, Use::Queues)),
+		num_gaps(0), state(nullptr), max_height(0), work(0), threads(std::max(1, (int) std::thread::hardware_concurrency())) {
+		for (int v = 0; v < n; ++v) {
+			new (&added_excess[v]) std::atomic<long long>(0);
+			new (&discovered[v]) std::atomic<char>(0);
+			new (&count[v]) std::atomic<int>(0);
+		}
+	}
+
+	void addEdge(int from, int to, Cap cap) {
+		if (from != to && from != t && to != s && cap >= 1) {
+			adj.addEdge(from, to, cap);
+		}
+	}
+
+	long long flow() {
+		adj.build();
+		pool.reset(new ThreadPool(threads));
+		// the pool decides the number of threads
+		state = arena.allocate<ThreadState>(pool->size(), Use::Queues);
+		for (int i = 0; i < pool->size(); ++i) {
+			new (&state[i]) ThreadState();
+			state[i].discovered = arena.allocate<int>(BATCH, Use::Queues);
+			state[i].pushes = arena.allocate<std::pair<int, Cap>>(BATCH, Use::Queues);
+		}
+		pushes = arena.allocate<std::pair<int, Cap>>(adj.num_arcs, Use::Queues);
+		std::fill(excess, excess + n, 0);
+		std::fill(added_excess, added_excess + n, 0);
+		std::fill(discovered, discovered + n, 0);
+		globalRelabel();
+		for (Arc<Cap>& e : adj.out(s)) {
+			if (height[e.to] < n) {
+				excess[e.to] += e.cap;
+				adj.arcs[e.rev].cap += e.cap;
+				e.cap = 0;
+			}
+		}
+		findActive();
+		ScopedPhase phase(times, times.phase("discharge"));
+		// Heights may end up too high when a vertex relabels without seeing
+		// the arcs its neighbors opened in the same round, so the run only
+		// ends once a global relabel finds no active vertex either.
+		bool relabeled = true;
+		while (num_working > 0 || !relabeled) {
+			if (num_working == 0 || 2 * work > 6LL * n + adj.num_arcs) {
+				globalRelabel();
+				findActive();
+				relabeled = true;
+				continue;
+			}
+			round();
+			relabeled = false;
+			progress.step(excess[t]);
+		}
+		return excess[t];
+	}
+
+	// Whether v may push to w when both are active (heights of the last round).
+	bool wins(int v, int w) const {
+		return height[v] == height[w] + 1 || height[v] < height[w] - 1 || (height[v] == height[w] && v < w);
+	}
+
+	bool active(int v) const {
+		return excess[v] > 0 && height[v] < n && v != s && v != t;
+	}
+
+	// Moves the batch of a thread to the end of a shared array.
+	template<class T>
+	static void flush(T* batch, int& size, T* shared, std::atomic<int>& shared_size) {
+		int begin = shared_size.fetch_add(size, std::memory_order_relaxed);
+		std::copy(batch, batch + size, shared + begin);
+		size = 0;
+	}
+
+	void discover(int v, ThreadState& local) {
+		local.discovered[local.num_discovered++] = v;
+		if (local.num_discovered == BATCH) flush(local.discovered, local.num_discovered, next, num_next);
+	}
+
+	void discharge(int v, ThreadState& local) {
+		long long e = excess[v];
+		int label = height[v];
+		while (e > 0) {
+			int relabel = n;
+			bool skipped = false;
+			for (int i = adj.first[v]; i < adj.first[v + 1] && e > 0; ++i) {
+				local.counts.arcs_scanned += 1;
+				Arc<Cap>& a = adj.arcs[i];
+				if (!a.cap) continue;
+				int w = a.to;
+				if (label == height[w] + 1) {
+					if (active(w) && !wins(v, w)) {
+						skipped = true;
+						continue;
+					}
+					Cap d = std::min<long long>(e, a.cap);
+					if (d == a.cap) local.counts.saturating_pushes += 1;
+					else local.counts.nonsaturating_pushes += 1;
+					a.cap -= d;
+					local.pushes[local.num_pushes++] = {a.rev, d};
+					if (local.num_pushes == BATCH) flush(local.pushes, local.num_pushes, pushes, num_pushes);
+					e -= d;
+					added_excess[w].fetch_add(d, std::memory_order_relaxed);
+					if (w != t && !discovered[w].exchange(1, std::memory_order_relaxed)) discover(w, local);
+				}
+				if (a.cap > 0 && height[w] >= label) relabel = std::min(relabel, height[w] + 1);
+			}
+			if (e == 0 || skipped) break;
+			local.counts.relabels += 1;
+			local.work += adj.first[v + 1] - adj.first[v] + 12;
+			label = relabel;
+			if (label == n) break;
+		}
+		new_height[v] = label;
+		if (label < n) local.max_height = std::max(local.max_height, label);
+		added_excess[v].fetch_add(e - excess[v], std::memory_order_relaxed);
+		if (e > 0 && !discovered[v].exchange(1, std::memory_order_relaxed)) discover(v, local);
+	}
+
+	void round() {
+		counts.phases += 1;
+		num_next.store(0, std::memory_order_relaxed);
+		num_pushes.store(0, std::memory_order_relaxed);
+		pool->forEach(num_working, GRAIN, [&](int i, int thread) {
+			discharge(working[i], state[thread]);
+		});
+		for (int i = 0; i < pool->size(); ++i) {
+			ThreadState& local = state[i];
+			flush(local.discovered, local.num_discovered, next, num_next);
+			flush(local.pushes, local.num_pushes, pushes, num_pushes);
+		}
+
+		// The reverse arcs of the pushes, new heights, the heights they leave
+		// empty and the excess of the vertices that emptied.
+		int num_pushed = num_pushes.load(std::memory_order_relaxed);
+		std::atomic<int> claimed_pushes(0), claimed(0);
+		auto finish = [&](int) {
+			int begin;
+			while ((begin = claimed_pushes.fetch_add(GRAIN, std::memory_order_relaxed)) < num_pushed) {
+				int end = std::min(begin + GRAIN, num_pushed);
+				for (int i = begin; i < end; ++i) adj.arcs[pushes[i].first].cap += pushes[i].second;
+			}
+			while ((begin = claimed.fetch_add(GRAIN, std::memory_order_relaxed)) < num_working) {
+				int end = std::min(begin + GRAIN, num_working);
+				for (int i = begin; i < end; ++i) {
+					int v = working[i];
+					if (!discovered[v].load(std::memory_order_relaxed)) excess[v] += added_excess[v].exchange(0, std::memory_order_relaxed);
+					if (new_height[v] == height[v]) continue;
+					if (count[height[v]].fetch_sub(1, std::memory_order_relaxed) == 1) {
+						gaps[num_gaps.fetch_add(1, std::memory_order_relaxed)] = height[v];
+					}
+					if (new_height[v] < n) count[new_height[v]].fetch_add(1, std::memory_order_relaxed);
+					height[v] = new_height[v];
+				}
+			}
+		};
+		if (num_working <= GRAIN && num_pushed <= GRAIN) finish(0);
+		else pool->run(finish);
+
+		for (int i = 0; i < pool->size(); ++i) {
+			ThreadState& local = state[i];
+			work += local.work;
+			local.work = 0;
+			max_height = std::max(max_height, local.max_height);
+			local.max_height = 0;
+			counts.arcs_scanned += local.counts.arcs_scanned.get();
+			counts.saturating_pushes += local.counts.saturating_pushes.get();
+			counts.nonsaturating_pushes += local.counts.nonsaturating_pushes.get();
+			counts.relabels += local.counts.relabels.get();
+			local.counts = OperationCounts();
+		}
+		int num_discovered = num_next.load(std::memory_order_relaxed);
+		pool->forEach(num_discovered, GRAIN, [&](int i, int) {
+			int v = next[i];
+			excess[v] += added_excess[v].exchange(0, std::memory_order_relaxed);
+			discovered[v].store(0, std::memory_order_relaxed);
+		});
+		excess[t] += added_excess[t].exchange(0, std::memory_order_relaxed);
+
+		int gap = n;
+		for (int i = 0; i < num_gaps.load(std::memory_order_relaxed); ++i) {
+			int h = gaps[i];
+			if (h < max_height && count[h].load(std::memory_order_relaxed) == 0) gap = std::min(gap, h);
+		}
+		num_gaps.store(0, std::memory_order_relaxed);
+		if (gap < n) {
+			// no vertex above the gap can reach t any more
+			counts.gaps += 1;
+			pool->forEach(n, GRAIN, [&](int v, int) {
+				if (gap < height[v] && height[v] < n && v != s) height[v] = n;
+			});
+			std::fill(count + gap, count + max_height + 1, 0);
+			max_height = gap - 1;
+		}
+
+		num_working = 0;
+		for (int i = 0; i < num_discovered; ++i) {
+			if (height[next[i]] < n) working[num_working++] = next[i];
+		}
+	}
+
+	// Exact distances to t by a breadth-first search that expands every
+	// level in parallel; discovered marks the vertices already reached.
+	void globalRelabel() {
+		ScopedPhase phase(times, times.phase("global_relabel"));
+		counts.global_relabels += 1;
+		work = 0;
+		pool->forEach(n, GRAIN, [&](int v, int) {
+			height[v] = n;
+			count[v].store(0, std::memory_order_relaxed);
+		});
+		height[t] = 0;
+		discovered[t].store(1, std::memory_order_relaxed);
+		discovered[s].store(1, std::memory_order_relaxed);
+		max_height = 0;
+		working[0] = t;
+		num_working = 1;
+		for (int level = 1; num_working > 0; ++level) {
+			num_next.store(0, std::memory_order_relaxed);
+			pool->forEach(num_working, GRAIN, [&](int i, int thread) {
+				for (const Arc<Cap>& e : adj.out(working[i])) {
+					state[thread].counts.arcs_scanned += 1;
+					if (!adj.arcs[e.rev].cap || discovered[e.to].exchange(1, std::memory_order_relaxed)) continue;
+					height[e.to] = level;
+					discover(e.to, state[thread]);
+				}
+			});
+			for (int i = 0; i < pool->size(); ++i) {
+				ThreadState& local = state[i];
+				flush(local.discovered, local.num_discovered, next, num_next);
+				counts.arcs_scanned += local.counts.arcs_scanned.get();
+				local.counts = OperationCounts();
+			}
+			std::swap(working, next);
+			num_working = num_next.load(std::memory_order_relaxed);
+			if (num_working == 0 || level >= n) continue;
+			count[level].store(num_working, std::memory_order_relaxed);
+			max_height = level;
+		}
+		height[s] = n;
+		pool->forEach(n, GRAIN, [&](int v, int) {
+			discovered[v].store(0, std::memory_order_relaxed);
+		});
+	}
+
+	// Working set of the vertices with excess that can still reach t.
+	void findActive() {
+		num_working = 0;
+		for (int v = 0; v < n; ++v) {
+			if (active(v)) working[num_working++] = v;
+		}
+	}
+};
@@ -0,0 +1,88 @@
+/*
+ * Push-relabel with the policies chosen on the command line (see
+ * push_relabel.h), so the whole matrix can be benchmarked with one
+ * executable. Every combination is compiled in.
+ * Usage: push_relabel [options] [file]
+ *   --selection=highest|lowest|fifo|wave  (default: highest)
+ *   --global-relabel=none|relabels|work   none: only at the start;
+ *                                         relabels: after 5 n relabels;
+ *                                         work: as in hi_pr (default: relabels)
+ *   --gaps=none|lists                     (default: lists)
+ *   --value-only                          stop after the first phase
+ */
+#include <cstdio>
+#include <string>
+
+#include "../common/solver_main.h"
+#include "push_relabel.h"
+
+template<class Policy>
+struct PolicyTag {
+	using type = Policy;
+};
+
+template<class Selection, class Trigger, class Gaps, class Phases>
+struct Policies {
+	template<class Cap>
+	using Solver = PushRelabel<Cap, Selection, Trigger, Gaps, Phases>;
+};
+
+template<class F>
+bool withSelection(const std::string& name, F&& f) {
+	if (name == "highest") f(PolicyTag<HighestLabel>());
+	else if (name == "lowest") f(PolicyTag<LowestLabel>());
+	else if (name == "fifo") f(PolicyTag<FIFO<>>());
+	else if (name == "wave") f(PolicyTag<Wave>());
+	else return false;
+	return true;
+}
+
+template<class F>
+bool withTrigger(const std::string& name, F&& f) {
+	if (name == "none") f(PolicyTag<NoGlobalRelabel>());
+	else if (name == "relabels") f(PolicyTag<RelabelCount<5>>());
+	else if (name == "work") f(PolicyTag<RelabelWork>());
+	else return false;
+	return true;
+}
+
+template<class F>
+bool withGaps(const std::string& name, F&& f) {
+	if (name == "none") f(PolicyTag<NoGaps>());
+	else if (name == "lists") f(PolicyTag<GapLists>());
+	else return false;
+	return true;
+}
+
+int main(int argc, char* argv[]) {
+	std::string selection = getOption(argc, argv, "selection", "highest");
+	std::string trigger = getOption(argc, argv, "global-relabel", "relabels");
+	std::string gaps = getOption(argc, argv, "gaps", "lists");
+	bool value_only = hasFlag(argc, argv, "value-only");
+	if (!withSelection(selection, [](auto) {})) {
+		std::fprintf(stderr, "unknown selection %s\n", selection.c_str());
+		return 2;
+	}
+	if (!withTrigger(trigger, [](auto) {})) {
+		std::fprintf(stderr, "unknown global relabel trigger %s\n", trigger.c_str());
+		return 2;
+	}
+	if (!withGaps(gaps, [](auto) {})) {
+		std::fprintf(stderr, "unknown gap strategy %s\n", gaps.c_str());
+		return 2;
+	}
+
+	int status = 0;
+	withSelection(selection, [&](auto s) {
+		withTrigger(trigger, [&](auto r) {
+			withGaps(gaps, [&](auto g) {
+				using S = typename decltype(s)::type;
+				using R = typename decltype(r)::type;
+				using G = typename decltype(g)::type;
+				if (value_only) status = runSolver<Policies<S, R, G, ValueOnly>::template Solver>(argc, argv);
+				else status = runSolver<Policies<S, R, G, TwoPhase>::template Solver>(argc, argv);
+			});
+		});
+	});
+	return status;
+}
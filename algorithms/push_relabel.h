@@ -0,0 +1,450 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+
+#include "../common/counters.h"
+#include "../common/phase_times.h"
+#include "../common/progress.h"
+#include "../common/residual_graph.h"
+
+// Preflow Push (Goldberg and Tarjan) with its strategies as policies.
+// PushRelabel<Cap, Selection, Trigger, Gaps, Phases> fixes at compile time
+//   Selection  which active vertex is discharged next
+//   Trigger    when all heights are recomputed by a breadth-first search
+//              from t (a global relabel; there is always one at the start)
+//   Gaps       whether a height that runs empty lifts the vertices above it
+//   Phases     whether the excess that cannot reach t returns to s
+// so every combination is a solver of its own without indirect calls.
+// hlpp.h, fifopp.h, hlpp_heuristic.h and fifopp_heuristic.h name the
+// combinations that have their own executables; push_relabel.cpp runs any.
+
+// Highest active vertex first.
+struct HighestLabel {
+	static const bool requeue = true;
+	const int limit;
+	// active vertices of height h form a stack: bucket[h], next[bucket[h]], ...
+	int *bucket, *next;
+	// no active vertex is above top
+	int top;
+
+	HighestLabel(int n, int _limit, Arena& arena) : limit(_limit),
+		bucket(arena.allocate<int>(limit, Use::Queues)), next(arena.allocate<int>(n, Use::Queues)), top(0) {}
+
+	// s, above every height, is the first vertex to discharge
+	void clear() {
+		std::fill(bucket, bucket + limit, -1);
+		top = limit - 1;
+	}
+
+	void add(int v, int h) {
+		addBelow(v, h);
+		top = std::max(top, h);
+	}
+
+	// h is below the vertex being discharged, so top stays
+	void addBelow(int v, int h) {
+		next[v] = bucket[h];
+		bucket[h] = v;
+	}
+
+	bool pop(int& v) {
+		for (; top > 0; --top) {
+			if (bucket[top] >= 0) {
+				v = bucket[top];
+				bucket[top] = next[v];
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+// Lowest active vertex first. A relabeled vertex waits for the ones below.
+struct LowestLabel {
+	static const bool requeue = true;
+	const int limit;
+	int *bucket, *next;
+	// no active vertex is below low
+	int low;
+
+	LowestLabel(int n, int _limit, Arena& arena) : limit(_limit),
+		bucket(arena.allocate<int>(limit, Use::Queues)), next(arena.allocate<int>(n, Use::Queues)), low(limit) {}
+
+	void clear() {
+		std::fill(bucket, bucket + limit, -1);
+		low = limit;
+	}
+
+	void add(int v, int h) {
+		next[v] = bucket[h];
+		bucket[h] = v;
+		low = std::min(low, h);
+	}
+
+	void addBelow(int v, int h) {
+		add(v, h);
+	}
+
+	bool pop(int& v) {
+		for (; low < limit; ++low) {
+			if (bucket[low] >= 0) {
+				v = bucket[low];
+				bucket[low] = next[v];
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+// Waves from the highest active vertex down. A wave takes the vertices it
+// activates below it along; a relabeled vertex waits for the next wave.
+struct Wave {
+	static const bool requeue = true;
+	const int limit;
+	int *bucket, *next;
+	// the wave is at height cursor; no active vertex is above both cursor
+	// and top
+	int cursor, top;
+
+	Wave(int n, int _limit, Arena& arena) : limit(_limit),
+		bucket(arena.allocate<int>(limit, Use::Queues)), next(arena.allocate<int>(n, Use::Queues)), cursor(0), top(0) {}
+
+	void clear() {
+		std::fill(bucket, bucket + limit, -1);
+		cursor = limit - 1;
+		top = 0;
+	}
+
+	void add(int v, int h) {
+		addBelow(v, h);
+		top = std::max(top, h);
+	}
+
+	// h is below the vertex being discharged, which the wave is at
+	void addBelow(int v, int h) {
+		next[v] = bucket[h];
+		bucket[h] = v;
+	}
+
+	bool pop(int& v) {
+		for (int wave = 0; wave < 2; ++wave) {
+			for (; cursor > 0; --cursor) {
+				if (bucket[cursor] >= 0) {
+					v = bucket[cursor];
+					bucket[cursor] = next[v];
+					return true;
+				}
+			}
+			cursor = top;
+			top = 0;
+		}
+		return false;
+	}
+};
+
+// Active vertices in first-in first-out order. A relabeled vertex goes to
+// the back of the queue, or with KeepTurn keeps discharging until it has
+// no excess, as in the original fifopp.
+template<bool KeepTurn = false>
+struct FIFO {
+	static const bool requeue = !KeepTurn;
+	const int n;
+	// every active vertex is in the circular queue exactly once
+	int* que;
+	int que_begin, que_size;
+
+	FIFO(int _n, int, Arena& arena) : n(_n), que(arena.allocate<int>(n, Use::Queues)), que_begin(0), que_size(0) {}
+
+	void clear() {
+		que_begin = 0;
+		que_size = 0;
+	}
+
+	void add(int v, int) {
+		int end = que_begin + que_size++;
+		que[end < n ? end : end - n] = v;
+	}
+
+	void addBelow(int v, int h) {
+		add(v, h);
+	}
+
+	bool pop(int& v) {
+		if (que_size == 0) return false;
+		v = que[que_begin];
+		if (++que_begin == n) que_begin = 0;
+		que_size -= 1;
+		return true;
+	}
+};
+
+// Only the global relabel at the start.
+struct NoGlobalRelabel {
+	static long long cost(int) {
+		return 0;
+	}
+
+	static bool due(long long, int, int) {
+		return false;
+	}
+};
+
+// After more than Factor n relabels.
+template<int Factor>
+struct RelabelCount {
+	static long long cost(int) {
+		return 1;
+	}
+
+	static bool due(long long work, int n, int) {
+		return work > (long long) Factor * n;
+	}
+};
+
+// Once the relabels since the last global relabel scanned about half as
+// many arcs as it does, counting 12 per relabel on top of its arcs (as in
+// hi_pr by Cherkassky and Goldberg).
+struct RelabelWork {
+	static long long cost(int degree) {
+		return 12 + degree;
+	}
+
+	static bool due(long long work, int n, int arcs) {
+		return 2 * work > 6LL * n + arcs;
+	}
+};
+
+// No gap detection.
+struct NoGaps {
+	NoGaps(int, Arena&) {}
+
+	void clear() {}
+	void link(int, int) {}
+	void unlink(int, int) {}
+
+	bool alone(int, int) const {
+		return false;
+	}
+
+	template<class F>
+	void lift(int, F&&) {}
+};
+
+// All vertices of height h < n other than s and t form a doubly linked
+// list: level[h], level_next[level[h]], ...; none is above top_level. A
+// gap only visits the vertices it lifts.
+struct GapLists {
+	const int n;
+	int *level, *level_next, *level_prev;
+	int top_level;
+
+	GapLists(int _n, Arena& arena) : n(_n), level(arena.allocate<int>(n, Use::Queues)),
+		level_next(arena.allocate<int>(n, Use::Queues)), level_prev(arena.allocate<int>(n, Use::Queues)), top_level(0) {}
+
+	void clear() {
+		std::fill(level, level + n, -1);
+		top_level = 0;
+	}
+
+	void link(int v, int h) {
+		level_prev[v] = -1;
+		level_next[v] = level[h];
+		if (level[h] >= 0) level_prev[level[h]] = v;
+		level[h] = v;
+		top_level = std::max(top_level, h);
+	}
+
+	void unlink(int v, int h) {
+		if (level_prev[v] >= 0) level_next[level_prev[v]] = level_next[v];
+		else level[h] = level_next[v];
+		if (level_next[v] >= 0) level_prev[level_next[v]] = level_prev[v];
+	}
+
+	bool alone(int v, int h) const {
+		return level[h] == v && level_next[v] < 0;
+	}
+
+	// Calls f(u) for every vertex from height gap up and empties the lists.
+	template<class F>
+	void lift(int gap, F&& f) {
+		for (int h = gap; h <= top_level; ++h) {
+			for (int u = level[h]; u >= 0; u = level_next[u]) f(u);
+			level[h] = -1;
+		}
+		top_level = gap - 1;
+	}
+};
+
+// Excess that cannot reach t rises up to height 2n and returns to s, so
+// the arcs hold a flow in the end.
+struct TwoPhase {
+	static const bool returns_excess = true;
+
+	static int limit(int n) {
+		return 2 * n;
+	}
+};
+
+// Stop once no active vertex is below height n. excess[t] is the flow
+// value then, but the excess above n has not returned to s, so the arcs
+// hold a preflow (see common/flow_recovery.h).
+struct ValueOnly {
+	static const bool returns_excess = false;
+
+	static int limit(int n) {
+		return n;
+	}
+};
+
+template<class Cap, class Selection, class Trigger, class Gaps, class Phases>
+struct PushRelabel {
+	const int n, s, t;
+	// no active vertex reaches this height
+	const int limit;
+	ResidualGraph<Cap> adj;
+	int *height, *iter, *que;
+	long long* excess;
+	Selection selection;
+	Gaps gaps;
+	long long work;
+	OperationCounts counts;
+	PhaseTimes times;
+	Progress progress;
+
+	PushRelabel(int _n, int _s, int _t, Arena& arena) : n(_n), s(_s), t(_t), limit(Phases::limit(n)), adj(n, arena),
+		height(arena.allocate<int>(n, Use::Vertices)), iter(arena.allocate<int>(n, Use::Vertices)),
+		que(arena.allocate<int>(n, Use::Queues)), excess(arena.allocate<long long>(n, Use::Vertices)),
+		selection(n, limit, arena), gaps(n, arena), work(0) {}
+
+	void addEdge(int from, int to, Cap cap) {
+		if (from != to && from != t && to != s && cap >= 1) {
+			adj.addEdge(from, to, cap);
+		}
+	}
+
+	long long flow() {
+		{
+			ScopedPhase phase(times, times.phase("preprocess"));
+			preprocess();
+		}
+		ScopedPhase phase(times, times.phase("discharge"));
+		int v;
+		while (selection.pop(v)) {
+			// lifted by a gap while waiting
+			if (height[v] >= limit) continue;
+			// discharge v: push along the admissible arcs from its current
+			// arc on, then relabel it, as long as it keeps its turn
+			do {
+				while (iter[v] < adj.first[v + 1]) {
+					counts.arcs_scanned += 1;
+					Arc<Cap>& e = adj.arcs[iter[v]];
+					if (e.cap > 0 && height[v] > height[e.to]) {
+						push(v, e);
+						if (excess[v] == 0) break;
+					}
+					iter[v] += 1;
+				}
+			} while (excess[v] > 0 && retreat(v));
+			progress.step(excess[t]);
+		}
+		return excess[t];
+	}
+
+	void preprocess() {
+		adj.build();
+		std::fill(height, height + n, n);
+		std::fill(excess, excess + n, 0);
+		excess[s] = std::numeric_limits<long long>::max();
+		globalRelabel();
+		for (Arc<Cap>& e : adj.out(s)) {
+			if (height[e.to] < n) push(s, e);
+		}
+	}
+
+	// Also rebuilds the selection and the gap lists, in order of distance
+	// to t.
+	void globalRelabel() {
+		ScopedPhase phase(times, times.phase("global_relabel"));
+		counts.global_relabels += 1;
+		for (int v = 0; v < n; ++v) {
+			// a vertex above n cannot reach t and keeps its height
+			height[v] = Phases::returns_excess ? std::max(height[v], n) : n;
+		}
+		std::copy(adj.first, adj.first + n, iter);
+		selection.clear();
+		gaps.clear();
+		work = 0;
+		int queBegin = 0;
+		int queEnd = 0;
+		height[t] = 0;
+		que[queEnd++] = t;
+		while (queBegin < queEnd) {
+			int v = que[queBegin++];
+			if (height[v] < n && v != s && v != t) {
+				gaps.link(v, height[v]);
+				if (excess[v] > 0) selection.add(v, height[v]);
+			}
+			for (const Arc<Cap>& e : adj.out(v)) {
+				counts.arcs_scanned += 1;
+				if (!adj.arcs[e.rev].cap || height[e.to] < n) continue;
+				height[e.to] = height[v] + 1;
+				que[queEnd++] = e.to;
+			}
+		}
+		height[s] = n;
+		if (Phases::returns_excess) {
+			for (int v = 0; v < n; ++v) {
+				if (height[v] >= n && excess[v] > 0 && v != s && v != t) selection.add(v, height[v]);
+			}
+		}
+	}
+
+	void push(int v, Arc<Cap>& e) {
+		if (!excess[e.to] && e.to != s && e.to != t) selection.addBelow(e.to, height[e.to]);
+		Cap d = std::min<long long>(excess[v], e.cap);
+		if (d == e.cap) counts.saturating_pushes += 1;
+		else counts.nonsaturating_pushes += 1;
+		e.cap -= d;
+		adj.arcs[e.rev].cap += d;
+		excess[v] -= d;
+		excess[e.to] += d;
+	}
+
+	void relabel(int v) {
+		counts.relabels += 1;
+		work += Trigger::cost(adj.first[v + 1] - adj.first[v]);
+		if (height[v] < n) gaps.unlink(v, height[v]);
+		height[v] = limit;
+		for (const Arc<Cap>& e : adj.out(v)) {
+			counts.arcs_scanned += 1;
+			if (e.cap > 0) {
+				height[v] = std::min(height[v], height[e.to] + 1);
+			}
+		}
+		if (height[v] < n) gaps.link(v, height[v]);
+	}
+
+	// v has no admissible arc left. Returns whether v keeps its turn; with
+	// Selection::requeue it goes back to the selection instead, and after a
+	// global relabel the selection starts over.
+	bool retreat(int v) {
+		if (height[v] < n && gaps.alone(v, height[v])) {
+			// v is alone at its height: no vertex from there up reaches t
+			counts.gaps += 1;
+			gaps.lift(height[v], [&](int u) { height[u] = n; });
+		}
+		else {
+			relabel(v);
+		}
+		iter[v] = adj.first[v];
+		if (Trigger::due(work, n, adj.num_arcs)) {
+			globalRelabel();
+			return false;
+		}
+		if (height[v] >= limit) return false;
+		if (Selection::requeue) selection.add(v, height[v]);
+		return !Selection::requeue;
+	}
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+#include "../common/counters.h"
+#include "../common/phase_times.h"
+#include "../common/progress.h"
+#include "../common/residual_graph.h"
+
+template<class Cap>
+struct FordFulkersonRandomDFS {
+	const int n, s, t;
+	ResidualGraph<Cap> adj;
+	bool* visited;
+	OperationCounts counts;
+	PhaseTimes times;
+	Progress progress;
+	uint64_t seed; // for the arc order, taken from the clock unless set
+
+	FordFulkersonRandomDFS(int _n, int _s, int _t, Arena& arena) : n(_n), s(_s), t(_t), adj(n, arena) {
+		seed = std::chrono::steady_clock::now().time_since_epoch().count();
+		visited = arena.allocate<bool>(n, Use::Vertices);
+	}
+
+	void addEdge(int from, int to, Cap cap) {
+		if (from != to && cap >= 1) {
+			adj.addEdge(from, to, cap);
+		}
+	}
+
+	Cap dfs(int v, Cap flow) {
+		if (v == t) return flow;
+		visited[v] = true;
+		for (Arc<Cap>& e : adj.out(v)) {
+			counts.arcs_scanned += 1;
+			if (!visited[e.to] && e.cap >= 1) {
+				Cap d = dfs(e.to, std::min(flow, e.cap));
+				if (d >= 1) {
+					e.cap -= d;
+					adj.arcs[e.rev].cap += d;
+					return d;
+				}
+			}
+		}
+		return 0;
+	}
+
+	long long flow() {
+		long long ans = 0;
+		std::mt19937 rng(seed);
+		adj.build();
+		adj.shuffleArcs(rng);
+		while (true) {
+			std::fill(visited, visited + n, false);
+			counts.phases += 1;
+			Cap d = dfs(s, std::numeric_limits<Cap>::max());
+			if (d == 0) break;
+			counts.augmenting_paths += 1;
+			ans += d;
+			progress.step(ans);
+		}
+		return ans;
+	}
+};
@@ -0,0 +1,76 @@
+/*
+ * All solvers by name.
+ * Description: SOLVERS lists the names of the solvers, which are also the
+ *   names of their executables. withSolver(name, f) calls
+ *   f(SolverTag<Solver>()) for the solver template of that name and
+ *   returns false if there is none. A function template taking
+ *   SolverTag<Solver> recovers Solver, e.g. to pass it to
+ *   generateAndSolve (see common/solver_sink.h). setSeed(g, seed) sets the
+ *   seed of solvers that have one and does nothing for the others.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "dfs.h"
+#include "dinic.h"
+#include "edmonds_karp.h"
+#include "fifopp.h"
+#include "fifopp_heuristic.h"
+#include "hlpp.h"
+#include "hlpp_heuristic.h"
+#include "most_improving.h"
+#include "parallel_pr.h"
+#include "random_dfs.h"
+#include "scaling_dfs.h"
+#include "scaling_dinic.h"
+
+template<template<class> class Solver>
+struct SolverTag {};
+
+const char* const SOLVERS[] = {
+	"dfs",
+	"dinic",
+	"edmonds_karp",
+	"fifopp",
+	"fifopp_heuristic",
+	"hlpp",
+	"hlpp_heuristic",
+	"most_improving",
+	"parallel_pr",
+	"random_dfs",
+	"scaling_dfs",
+	"scaling_dinic",
+};
+
+template<class G>
+auto setSeedIfAny(G& g, uint64_t seed, int) -> decltype(g.seed = seed, void()) {
+	g.seed = seed;
+}
+
+template<class G>
+void setSeedIfAny(G&, uint64_t, long) {}
+
+template<class G>
+void setSeed(G& g, uint64_t seed) {
+	setSeedIfAny(g, seed, 0);
+}
+
+template<class F>
+bool withSolver(const std::string& name, F&& f) {
+	if (name == "dfs") f(SolverTag<FordFulkersonDFS>());
+	else if (name == "dinic") f(SolverTag<Dinic>());
+	else if (name == "edmonds_karp") f(SolverTag<EdmondsKarp>());
+	else if (name == "fifopp") f(SolverTag<FIFOPP>());
+	else if (name == "fifopp_heuristic") f(SolverTag<FIFOPPHeuristic>());
+	else if (name == "hlpp") f(SolverTag<HLPP>());
+	else if (name == "hlpp_heuristic") f(SolverTag<HLPPHeuristic>());
+	else if (name == "most_improving") f(SolverTag<MostImprovingAugmentingPaths>());
+	else if (name == "parallel_pr") f(SolverTag<ParallelPushRelabel>());
+	else if (name == "random_dfs") f(SolverTag<FordFulkersonRandomDFS>());
+	else if (name == "scaling_dfs") f(SolverTag<ScalingDFS>());
+	else if (name == "scaling_dinic") f(SolverTag<ScalingDinic>());
+	else return false;
+	return true;
+}
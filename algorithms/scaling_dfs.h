@@ -0,0 +1,74 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <string>
+
+#include "../common/counters.h"
+#include "../common/phase_times.h"
+#include "../common/progress.h"
+#include "../common/residual_graph.h"
+
+template<class Cap>
+struct ScalingDFS {
+	const int n, s, t;
+	ResidualGraph<Cap> adj;
+	bool* visited;
+	OperationCounts counts;
+	PhaseTimes times;
+	Progress progress;
+	Cap threshold;
+
+	ScalingDFS(int _n, int _s, int _t, Arena& arena) : n(_n), s(_s), t(_t), adj(n, arena) {
+		visited = arena.allocate<bool>(n, Use::Vertices);
+	}
+
+	void addEdge(int from, int to, Cap cap) {
+		if (from != to && cap >= 1) {
+			adj.addEdge(from, to, cap);
+		}
+	}
+
+	Cap dfs(int v, Cap flow) {
+		if (v == t) return flow;
+		visited[v] = true;
+		for (Arc<Cap>& e : adj.out(v)) {
+			counts.arcs_scanned += 1;
+			if (!visited[e.to] && e.cap >= threshold) {
+				Cap d = dfs(e.to, std::min(flow, e.cap));
+				if (d >= 1) {
+					e.cap -= d;
+					adj.arcs[e.rev].cap += d;
+					return d;
+				}
+			}
+		}
+		return 0;
+	}
+
+	// Largest power of two that is at most the largest capacity.
+	Cap topThreshold() {
+		Cap max_cap = adj.maxCap();
+		Cap res = 1;
+		while (res <= max_cap / 2) res *= 2;
+		return res;
+	}
+
+	long long flow() {
+		long long flow = 0;
+		adj.build();
+		for (threshold = topThreshold(); threshold >= 1; threshold /= 2) {
+			ScopedPhase phase(times, times.phase("threshold " + std::to_string((long long) threshold)));
+			while (true) {
+				std::fill(visited, visited + n, false);
+				counts.phases += 1;
+				Cap d = dfs(s, std::numeric_limits<Cap>::max());
+				if (d == 0) break;
+				counts.augmenting_paths += 1;
+				flow += d;
+				progress.step(flow);
+			}
+		}
+		return flow;
+	}
+};
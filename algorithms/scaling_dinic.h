@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <string>
+
+#include "../common/counters.h"
+#include "../common/phase_times.h"
+#include "../common/progress.h"
+#include "../common/residual_graph.h"
+
+template<class Cap>
+struct ScalingDinic {
+	const int n, s, t;
+	ResidualGraph<Cap> adj;
+	int *label, *que, *iter;
+	OperationCounts counts;
+	PhaseTimes times;
+	Progress progress;
+	Cap threshold;
+
+	ScalingDinic(int _n, int _s, int _t, Arena& arena) : n(_n), s(_s), t(_t), adj(n, arena) {
+		label = arena.allocate<int>(n, Use::Vertices);
+		que = arena.allocate<int>(n, Use::Queues);
+		iter = arena.allocate<int>(n, Use::Vertices);
+	}
+
+	void addEdge(int from, int to, Cap cap) {
+		if (from != to && cap >= 1) {
+			adj.addEdge(from, to, cap);
+		}
+	}
+
+	// Largest power of two that is at most the largest capacity.
+	Cap topThreshold() {
+		Cap max_cap = adj.maxCap();
+		Cap res = 1;
+		while (res <= max_cap / 2) res *= 2;
+		return res;
+	}
+
+	long long flow() {
+		long long ans = 0;
+		adj.build();
+		for (threshold = topThreshold(); threshold >= 1; threshold /= 2) {
+			ScopedPhase phase(times, times.phase("threshold " + std::to_string((long long) threshold)));
+			while (bfs()) {
+				std::copy(adj.first, adj.first + n, iter);
+				ans += dfs(t, std::numeric_limits<long long>::max());
+				progress.step(ans);
+			}
+		}
+		return ans;
+	}
+
+	bool bfs() {
+		counts.phases += 1;
+		std::fill(label, label + n, n);
+		label[s] = 0;
+		que[0] = s;
+		int queBegin = 0;
+		int queEnd = 1;
+		while (queBegin < queEnd) {
+			int v = que[queBegin++];
+			for (const Arc<Cap>& e : adj.out(v)) {
+				counts.arcs_scanned += 1;
+				if (e.cap < threshold || label[e.to] < n) continue;
+				label[e.to] = label[v] + 1;
+				if (e.to == t) return true;
+				que[queEnd++] = e.to;
+			}
+		}
+		return false;
+	}
+
+	long long dfs(int v, long long up) {
+		if (v == s) {
+			counts.augmenting_paths += 1;
+			return up;
+		}
+		long long res = 0;
+		for (; iter[v] < adj.first[v + 1]; ++iter[v]) {
+			counts.arcs_scanned += 1;
+			Arc<Cap>& e = adj.arcs[iter[v]];
+			Arc<Cap>& r = adj.arcs[e.rev];
+			if (r.cap < threshold) continue;
+			if (label[v] <= label[e.to]) continue;
+			Cap d = dfs(e.to, std::min(1LL * r.cap, up - res));
+			e.cap += d;
+			r.cap -= d;
+			res += d;
+			if (up - res < threshold) return res;
+		}
+		label[v] = n;
+		return res;
+	}
+};
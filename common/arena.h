@@ -0,0 +1,101 @@
+/*
+ * Scratch arena shared by the graph and the solvers.
+ * Description: Bump allocator for the arrays a solve needs. Memory is
+ *   handed out uninitialized and released all at once by reset(), which
+ *   keeps it for the next solve instead of returning it to the OS. When
+ *   a solve needs more than one block, reset() merges the blocks into
+ *   one, so solving a stream of similar instances stops allocating after
+ *   the first one. Every allocation names its Use, and allocated(use)
+ *   tallies the bytes per use since the last reset(), so the memory of a
+ *   solve can be broken down into arcs, per-vertex state and queues.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// What arena memory holds: the arcs of the residual graph and their
+// offsets, per-vertex state (labels, excess, ...), or queues, stacks,
+// buckets and heaps.
+enum class Use { Arcs, Vertices, Queues };
+
+const int NUM_USES = 3;
+
+inline const char* useName(Use use) {
+	static const char* const NAMES[NUM_USES] = {"arcs", "vertices", "queues"};
+	return NAMES[(int) use];
+}
+
+class Arena {
+private:
+	struct Block {
+		std::unique_ptr<char[]> data;
+		size_t size;
+	};
+
+	std::vector<Block> blocks;
+	size_t used;
+	size_t bytes_by_use[NUM_USES] = {};
+
+	void addBlock(size_t size) {
+		blocks.push_back({std::unique_ptr<char[]>(new char[size]), size});
+		used = 0;
+	}
+
+	// First offset from offset on in the last block whose address is a
+	// multiple of align, which may exceed what new[] guarantees.
+	size_t alignedOffset(size_t offset, size_t align) const {
+		uintptr_t address = (uintptr_t) blocks.back().data.get() + offset;
+		return offset + (align - address % align) % align;
+	}
+
+public:
+	Arena(size_t initial = 1 << 16) : used(0) {
+		addBlock(initial);
+	}
+
+	template<class T>
+	T* allocate(size_t count, Use use) {
+		static_assert(std::is_trivially_destructible<T>::value, "arena memory is never destroyed");
+		size_t align = alignof(T);
+		size_t begin = alignedOffset(used, align);
+		size_t bytes = count * sizeof(T);
+		if (begin + bytes > blocks.back().size) {
+			addBlock(std::max(bytes + align, 2 * capacity()));
+			begin = alignedOffset(0, align);
+		}
+		used = begin + bytes;
+		bytes_by_use[(int) use] += bytes;
+		return reinterpret_cast<T*>(blocks.back().data.get() + begin);
+	}
+
+	void reset() {
+		if (blocks.size() > 1) {
+			size_t total = capacity();
+			blocks.clear();
+			addBlock(total);
+		}
+		used = 0;
+		std::fill(bytes_by_use, bytes_by_use + NUM_USES, 0);
+	}
+
+	size_t allocated(Use use) const {
+		return bytes_by_use[(int) use];
+	}
+
+	size_t allocated() const {
+		size_t total = 0;
+		for (size_t bytes : bytes_by_use) total += bytes;
+		return total;
+	}
+
+	size_t capacity() const {
+		size_t total = 0;
+		for (const Block& b : blocks) total += b.size;
+		return total;
+	}
+};
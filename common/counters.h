@@ -0,0 +1,98 @@
+/*
+ * Operation counters of the solvers.
+ * Description: Every solver has a member counts of type OperationCounts
+ *   that tallies the work done by flow(), so a slowdown can be told apart
+ *   from more work. Counting is opt-in: only when MAXFLOW_COUNTERS is
+ *   defined (g++ -DMAXFLOW_COUNTERS ...) does a Counter hold a value.
+ *   Otherwise it is an empty class whose += does nothing, so the solvers
+ *   compile to the same code as without counters. runSolver writes the
+ *   counts to stderr as one JSON object after the flow value. A Counter
+ *   is a relaxed atomic with a single writer, so a progress reporter
+ *   thread may read it during the solve (see progress.h).
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdio>
+
+#ifdef MAXFLOW_COUNTERS
+const bool COUNTERS_ENABLED = true;
+
+class Counter {
+private:
+	std::atomic<long long> value{0};
+
+public:
+	Counter() {}
+
+	Counter(const Counter& other) : value(other.get()) {}
+
+	Counter& operator=(const Counter& other) {
+		value.store(other.get(), std::memory_order_relaxed);
+		return *this;
+	}
+
+	// Only the solver's thread writes, so load and store need no fence.
+	void operator+=(long long x) {
+		value.store(value.load(std::memory_order_relaxed) + x, std::memory_order_relaxed);
+	}
+
+	long long get() const {
+		return value.load(std::memory_order_relaxed);
+	}
+};
+#else
+const bool COUNTERS_ENABLED = false;
+
+class Counter {
+public:
+	void operator+=(long long) {}
+
+	long long get() const {
+		return 0;
+	}
+};
+#endif
+
+struct OperationCounts {
+	// Flow augmentations along a path from s to t. For Dinic, every path
+	// of a blocking flow counts.
+	Counter augmenting_paths;
+	// Searches for augmenting paths or level graphs (BFS, DFS, Dijkstra).
+	Counter phases;
+	// Pushes that do or do not saturate their arc.
+	Counter saturating_pushes;
+	Counter nonsaturating_pushes;
+	Counter relabels;
+	// Gap heuristic applications and exact relabelings by BFS from t.
+	Counter gaps;
+	Counter global_relabels;
+	// Heap pushes and pops.
+	Counter heap_operations;
+	// Arcs examined by searches, pushes and relabels.
+	Counter arcs_scanned;
+
+	// Calls f(name, value) for every counter.
+	template<class F>
+	void forEach(F&& f) const {
+		f("augmenting_paths", augmenting_paths.get());
+		f("phases", phases.get());
+		f("saturating_pushes", saturating_pushes.get());
+		f("nonsaturating_pushes", nonsaturating_pushes.get());
+		f("relabels", relabels.get());
+		f("gaps", gaps.get());
+		f("global_relabels", global_relabels.get());
+		f("heap_operations", heap_operations.get());
+		f("arcs_scanned", arcs_scanned.get());
+	}
+};
+
+// Writes the counts as one line of JSON.
+inline void writeCounts(FILE* out, const OperationCounts& counts) {
+	const char* separator = "{";
+	counts.forEach([&](const char* name, long long value) {
+		std::fprintf(out, "%s\"%s\": %lld", separator, name, value);
+		separator = ", ";
+	});
+	std::fprintf(out, "}\n");
+}
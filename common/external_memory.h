@@ -0,0 +1,177 @@
+/*
+ * External memory helpers for generators whose output does not fit in RAM.
+ * Description: Temporary files are created in $TMPDIR (default /tmp) and
+ *   unlinked right away, so they disappear with the process.
+ *     - ExternalSorter collects records in a buffer of bounded size,
+ *       sorts every full buffer into a run on disk and merges the runs
+ *       when the records are read back. Less has to be a total order if
+ *       the output must not depend on the buffer size.
+ *     - FileArray is a zero-initialized array backed by a temporary file,
+ *       for state that needs random access. The kernel writes its pages
+ *       out under memory pressure instead of running out of memory.
+ *   Records have to be trivially copyable.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+inline FILE* tempFile() {
+	const char* dir = std::getenv("TMPDIR");
+	std::string path = std::string(dir && *dir ? dir : "/tmp") + "/maxflow.XXXXXX";
+	int fd = mkstemp(&path[0]);
+	if (fd < 0) {
+		throw std::runtime_error("cannot create temporary file " + path + ": " + std::strerror(errno));
+	}
+	unlink(path.c_str());
+	return fdopen(fd, "w+b");
+}
+
+template<class T, class Less = std::less<T>>
+class ExternalSorter {
+private:
+	static_assert(std::is_trivially_copyable<T>::value, "records are written to disk as bytes");
+
+	struct Run {
+		FILE* file;
+		std::vector<T> buffer;
+		size_t pos;
+
+		bool refill() {
+			buffer.resize(buffer.capacity());
+			buffer.resize(std::fread(buffer.data(), sizeof(T), buffer.size(), file));
+			pos = 0;
+			return !buffer.empty();
+		}
+	};
+
+	const size_t capacity;
+	Less less;
+	std::vector<T> buffer;
+	std::vector<FILE*> runs;
+	size_t count;
+
+	void spill() {
+		std::sort(buffer.begin(), buffer.end(), less);
+		FILE* file = tempFile();
+		if (std::fwrite(buffer.data(), sizeof(T), buffer.size(), file) != buffer.size()) {
+			throw std::runtime_error("cannot write temporary file");
+		}
+		runs.push_back(file);
+		buffer.clear();
+	}
+
+public:
+	// memory is the number of bytes used for buffering, in both phases.
+	ExternalSorter(size_t memory, Less _less = Less())
+		: capacity(std::max<size_t>(memory / sizeof(T), 1)), less(_less), count(0) {}
+
+	ExternalSorter(const ExternalSorter&) = delete;
+	ExternalSorter& operator=(const ExternalSorter&) = delete;
+
+	~ExternalSorter() {
+		for (FILE* file : runs) std::fclose(file);
+	}
+
+	void push(const T& x) {
+		if (buffer.size() == capacity) spill();
+		buffer.push_back(x);
+		count += 1;
+	}
+
+	size_t size() const {
+		return count;
+	}
+
+	// Calls f(x) for every record in sorted order. Can be called repeatedly.
+	template<class F>
+	void forEach(F&& f) {
+		if (runs.empty()) {
+			std::sort(buffer.begin(), buffer.end(), less);
+			for (const T& x : buffer) f(x);
+			return;
+		}
+		if (!buffer.empty()) spill();
+		std::vector<T>().swap(buffer);
+
+		size_t k = runs.size();
+		std::vector<Run> readers(k);
+		for (size_t i = 0; i < k; ++i) {
+			std::rewind(runs[i]);
+			readers[i].file = runs[i];
+			readers[i].buffer.reserve(std::max<size_t>(capacity / k, 1));
+		}
+
+		// Min-heap of run indices; ties go to the earlier run.
+		auto after = [&](size_t a, size_t b) {
+			const T& x = readers[a].buffer[readers[a].pos];
+			const T& y = readers[b].buffer[readers[b].pos];
+			if (less(y, x)) return true;
+			if (less(x, y)) return false;
+			return a > b;
+		};
+		std::vector<size_t> heap;
+		for (size_t i = 0; i < k; ++i) {
+			if (readers[i].refill()) heap.push_back(i);
+		}
+		std::make_heap(heap.begin(), heap.end(), after);
+
+		while (!heap.empty()) {
+			std::pop_heap(heap.begin(), heap.end(), after);
+			Run& r = readers[heap.back()];
+			f(r.buffer[r.pos++]);
+			if (r.pos < r.buffer.size() || r.refill()) {
+				std::push_heap(heap.begin(), heap.end(), after);
+			}
+			else {
+				heap.pop_back();
+			}
+		}
+	}
+};
+
+template<class T>
+class FileArray {
+private:
+	static_assert(std::is_trivially_copyable<T>::value, "elements live in a file");
+
+	T* data;
+	size_t bytes;
+
+public:
+	FileArray(size_t count) : data(nullptr), bytes(std::max<size_t>(count * sizeof(T), 1)) {
+		FILE* file = tempFile();
+		if (ftruncate(fileno(file), bytes) != 0) {
+			std::fclose(file);
+			throw std::runtime_error("cannot resize temporary file");
+		}
+		void* area = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fileno(file), 0);
+		std::fclose(file);
+		if (area == MAP_FAILED) {
+			throw std::runtime_error("cannot map temporary file");
+		}
+		data = (T*) area;
+	}
+
+	FileArray(const FileArray&) = delete;
+	FileArray& operator=(const FileArray&) = delete;
+
+	~FileArray() {
+		munmap(data, bytes);
+	}
+
+	T& operator[](size_t i) {
+		return data[i];
+	}
+};
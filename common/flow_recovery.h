@@ -0,0 +1,106 @@
+/*
+ * Flow on every input edge.
+ * Description: The flow on an input edge is the residual capacity of the
+ *   reverse of its arc. Solvers that stop after the first phase of
+ *   push-relabel (parallel_pr and the ValueOnly variants of PushRelabel,
+ *   see algorithms/push_relabel.h) leave a preflow: vertices other than s
+ *   and t may keep excess, so these values are not yet a flow. recoverFlow
+ *   turns the preflow into a flow of the same value: a depth-first search
+ *   over the arcs that carry flow cancels every flow cycle, which leaves
+ *   the flow acyclic and yields a topological order, and then every vertex,
+ *   in reverse topological order, sends its excess back along the edges it
+ *   receives flow from. On a flow it only cancels cycles. edge_arcs holds
+ *   the arc of every input edge, -1 for edges the solver dropped (see
+ *   ResidualGraph::edge_arcs). runSolver does this for --flows=FILE.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "residual_graph.h"
+
+template<class Cap>
+void recoverFlow(ResidualGraph<Cap>& adj, const std::vector<int>& edge_arcs, int s, int t) {
+	const int n = adj.n;
+	std::vector<char> forward(adj.num_arcs, 0);
+	for (int a : edge_arcs) {
+		if (a >= 0) forward[a] = 1;
+	}
+	auto flow = [&](int a) -> Cap {
+		return adj.arcs[adj.arcs[a].rev].cap;
+	};
+	auto reduce = [&](int a, Cap d) {
+		adj.arcs[a].cap += d;
+		adj.arcs[adj.arcs[a].rev].cap -= d;
+	};
+
+	// Vertices finish after every vertex they send flow to.
+	enum : char { WHITE, GREY, BLACK };
+	std::vector<char> color(n, WHITE);
+	std::vector<int> iter(adj.first, adj.first + n), in_arc(n), pos(n), stack, order;
+	for (int root = 0; root < n; ++root) {
+		if (color[root] != WHITE) continue;
+		color[root] = GREY;
+		pos[root] = 0;
+		stack.push_back(root);
+		while (!stack.empty()) {
+			int v = stack.back();
+			int& i = iter[v];
+			while (i < adj.first[v + 1] && (!forward[i] || !flow(i) || color[adj.arcs[i].to] == BLACK)) ++i;
+			if (i == adj.first[v + 1]) {
+				color[v] = BLACK;
+				order.push_back(v);
+				stack.pop_back();
+				continue;
+			}
+			int w = adj.arcs[i].to;
+			if (color[w] == WHITE) {
+				color[w] = GREY;
+				in_arc[w] = i;
+				pos[w] = (int) stack.size();
+				stack.push_back(w);
+				continue;
+			}
+			// w is on the stack: cancel the cycle w, ..., v, w and continue
+			// from the tail of its first arc that ran empty
+			Cap d = flow(i);
+			for (int k = pos[w] + 1; k < (int) stack.size(); ++k) d = std::min(d, flow(in_arc[stack[k]]));
+			reduce(i, d);
+			int keep = (int) stack.size();
+			for (int k = pos[w] + 1; k < (int) stack.size(); ++k) {
+				reduce(in_arc[stack[k]], d);
+				if (!flow(in_arc[stack[k]]) && keep == (int) stack.size()) keep = k;
+			}
+			for (int k = keep; k < (int) stack.size(); ++k) color[stack[k]] = WHITE;
+			stack.resize(keep);
+		}
+	}
+
+	std::vector<long long> excess(n, 0);
+	for (int a : edge_arcs) {
+		if (a < 0) continue;
+		excess[adj.arcs[a].to] += flow(a);
+		excess[adj.arcs[adj.arcs[a].rev].to] -= flow(a);
+	}
+	for (int v : order) {
+		if (v == s || v == t) continue;
+		for (int b = adj.first[v]; b < adj.first[v + 1] && excess[v] > 0; ++b) {
+			// b is the reverse of an edge into v carrying b.cap
+			if (forward[b] || !adj.arcs[b].cap) continue;
+			Cap d = std::min<long long>(excess[v], adj.arcs[b].cap);
+			reduce(adj.arcs[b].rev, d);
+			excess[v] -= d;
+			excess[adj.arcs[b].to] += d;
+		}
+	}
+}
+
+// Writes the flow on every input edge, one per line, in input order.
+template<class Cap>
+void writeFlows(FILE* out, const ResidualGraph<Cap>& adj, const std::vector<int>& edge_arcs) {
+	for (int a : edge_arcs) {
+		std::fprintf(out, "%lld\n", a < 0 ? 0LL : (long long) adj.arcs[adj.arcs[a].rev].cap);
+	}
+}
@@ -0,0 +1,80 @@
+/*
+ * Running work in a forked child with a timeout.
+ * Description: runForked(body, timeout) calls body(fd) in a child process
+ *   and collects what it writes to fd. The child is killed when timeout
+ *   seconds have passed, so a run that takes exponential time, crashes or
+ *   fails an assertion only loses its own result. body returns the exit
+ *   status of the child. The benchmark and differential tools run their
+ *   cells and solvers this way.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+struct ForkedRun {
+	std::string output;
+	// "ok", "timeout" or "error" (the child crashed or exited with a
+	// nonzero status)
+	const char* status;
+};
+
+template<class Body>
+ForkedRun runForked(Body body, double timeout) {
+	int fds[2];
+	if (pipe(fds) != 0) {
+		std::perror("pipe");
+		std::exit(1);
+	}
+	// Otherwise the child would write the parent's buffered output again.
+	std::fflush(stdout);
+	std::fflush(stderr);
+	pid_t pid = fork();
+	if (pid < 0) {
+		std::perror("fork");
+		std::exit(1);
+	}
+	if (pid == 0) {
+		close(fds[0]);
+		_exit(body(fds[1]));
+	}
+
+	close(fds[1]);
+	ForkedRun res;
+	bool timed_out = false;
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(timeout);
+	while (true) {
+		auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+		if (left <= 0) {
+			timed_out = true;
+			break;
+		}
+		pollfd p = {fds[0], POLLIN, 0};
+		int ready = poll(&p, 1, (int) std::min<long long>(left, 1000));
+		if (ready < 0 && errno == EINTR) continue;
+		if (ready <= 0) continue;
+		char buffer[4096];
+		ssize_t got = read(fds[0], buffer, sizeof(buffer));
+		if (got < 0 && errno == EINTR) continue;
+		if (got <= 0) break;
+		res.output.append(buffer, got);
+	}
+	close(fds[0]);
+	if (timed_out) kill(pid, SIGKILL);
+	int wstatus;
+	while (waitpid(pid, &wstatus, 0) < 0 && errno == EINTR) {}
+
+	if (timed_out) res.status = "timeout";
+	else if (!WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0) res.status = "error";
+	else res.status = "ok";
+	return res;
+}
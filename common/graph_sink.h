@@ -0,0 +1,43 @@
+/*
+ * Sinks for the graphs produced by the generators.
+ * Description: Every generator has a library form
+ *   (generators/<name>.h) that passes its graph to a sink instead of
+ *   printing it. The generator calls sink.begin(n, m, s, t, max_cap)
+ *   once, then sink.edge(from, to, cap) for each of the m edges, with
+ *   1-based vertices. max_cap bounds all capacities.
+ *     - FileSink writes the graph in one of the formats of graph_writer.h.
+ *     - SolverSink (solver_sink.h) builds a solver's residual graph
+ *       directly, so nothing is serialized.
+ */
+#pragma once
+
+#include <memory>
+
+#include <unistd.h>
+
+#include "graph_writer.h"
+
+class FileSink {
+private:
+	const Format format;
+	const int threads, fd;
+	std::unique_ptr<GraphWriter> writer;
+
+public:
+	FileSink(Format _format, int _threads = 1, int _fd = STDOUT_FILENO)
+		: format(_format), threads(_threads), fd(_fd) {}
+
+	void begin(long long n, long long m, int s, int t, long long max_cap) {
+		writer.reset();
+		writer.reset(new GraphWriter(format, n, m, s, t, max_cap, threads, fd));
+	}
+
+	void edge(int from, int to, long long cap) {
+		writer->edge(from, to, cap);
+	}
+
+	// Writes out everything that is still buffered.
+	void finish() {
+		if (writer) writer->finish();
+	}
+};
@@ -0,0 +1,166 @@
+/*
+ * Graph writer shared by all generators.
+ * Description: Writes a graph with n vertices and m edges in one of the
+ *   formats understood by instance_reader.h. Vertices are passed 1-based,
+ *   as the generators number them. The text format has no way to name
+ *   the source and sink, so it requires s = 1 and t = n.
+ *   Edges are collected in batches, formatted with std::to_chars and
+ *   written with write(2). With threads > 1, up to that many batches are
+ *   formatted concurrently while the caller keeps producing edges; they
+ *   are written in the order they were filled, so the output does not
+ *   depend on the number of threads. Everything is written by the time
+ *   the writer is destroyed.
+ */
+#pragma once
+
+#include <cassert>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "binary_format.h"
+
+enum class Format {
+	Text, Dimacs, Binary
+};
+
+inline Format parseFormat(const char* name) {
+	if (std::strcmp(name, "text") == 0) return Format::Text;
+	if (std::strcmp(name, "dimacs") == 0) return Format::Dimacs;
+	if (std::strcmp(name, "binary") == 0) return Format::Binary;
+	throw std::invalid_argument(std::string("unknown format ") + name);
+}
+
+class GraphWriter {
+private:
+	struct Record {
+		int from, to;
+		long long cap;
+	};
+
+	static const size_t BATCH_SIZE = 1 << 16;
+	// "a " + three numbers of at most 20 characters, two spaces and '\n'
+	static const size_t MAX_LINE = 65;
+
+	const int fd;
+	const Format format;
+	const int vertex_width, cap_width;
+	const int threads;
+	std::vector<Record> batch;
+	std::deque<std::future<std::string>> pending;
+
+	static char* writeInt(char* p, long long x) {
+		return std::to_chars(p, p + 20, x).ptr;
+	}
+
+	std::string formatBatch(const std::vector<Record>& records) const {
+		std::string buffer(records.size() * MAX_LINE, '\0');
+		char* p = &buffer[0];
+		for (const Record& r : records) {
+			if (format == Format::Binary) {
+				p = packInt(p, r.from - 1, vertex_width);
+				p = packInt(p, r.to - 1, vertex_width);
+				p = packInt(p, r.cap, cap_width);
+				continue;
+			}
+			if (format == Format::Dimacs) {
+				*p++ = 'a';
+				*p++ = ' ';
+			}
+			p = writeInt(p, r.from);
+			*p++ = ' ';
+			p = writeInt(p, r.to);
+			*p++ = ' ';
+			p = writeInt(p, r.cap);
+			*p++ = '\n';
+		}
+		buffer.resize(p - buffer.data());
+		return buffer;
+	}
+
+	void writeAll(const char* p, size_t size) const {
+		while (size > 0) {
+			ssize_t done = write(fd, p, size);
+			if (done < 0 && errno == EINTR) continue;
+			if (done < 0) throw std::runtime_error(std::string("cannot write output: ") + std::strerror(errno));
+			p += done;
+			size -= done;
+		}
+	}
+
+	void writeOldest() {
+		std::string buffer = pending.front().get();
+		pending.pop_front();
+		writeAll(buffer.data(), buffer.size());
+	}
+
+	void flushBatch() {
+		if (batch.empty()) return;
+		if (threads <= 1) {
+			std::string buffer = formatBatch(batch);
+			writeAll(buffer.data(), buffer.size());
+			batch.clear();
+			return;
+		}
+		if ((int) pending.size() == threads) writeOldest();
+		pending.push_back(std::async(std::launch::async, [this, records = std::move(batch)] {
+			return formatBatch(records);
+		}));
+		batch = std::vector<Record>();
+		batch.reserve(BATCH_SIZE);
+	}
+
+public:
+	GraphWriter(Format _format, long long n, long long m, int s, int t, long long max_cap, int _threads = 1, int _fd = STDOUT_FILENO)
+		: fd(_fd), format(_format), vertex_width(vertexWidth(n)), cap_width(capWidth(max_cap)), threads(_threads) {
+		std::string header;
+		if (format == Format::Text) {
+			assert(s == 1 && t == n);
+			header = std::to_string(n) + ' ' + std::to_string(m) + '\n';
+		}
+		else if (format == Format::Dimacs) {
+			header = "p max " + std::to_string(n) + ' ' + std::to_string(m) + '\n';
+			header += "n " + std::to_string(s) + " s\n";
+			header += "n " + std::to_string(t) + " t\n";
+		}
+		else {
+			BinaryHeader h = binaryHeader(n, m, s - 1, t - 1, max_cap);
+			header.assign((const char*) &h, sizeof(h));
+		}
+		writeAll(header.data(), header.size());
+		batch.reserve(BATCH_SIZE);
+	}
+
+	GraphWriter(const GraphWriter&) = delete;
+	GraphWriter& operator=(const GraphWriter&) = delete;
+
+	~GraphWriter() {
+		try {
+			finish();
+		}
+		catch (const std::exception& e) {
+			std::fprintf(stderr, "%s\n", e.what());
+			std::_Exit(1);
+		}
+	}
+
+	void edge(int from, int to, long long cap) {
+		batch.push_back({from, to, cap});
+		if (batch.size() == BATCH_SIZE) flushBatch();
+	}
+
+	// Writes out everything that is still buffered.
+	void finish() {
+		flushBatch();
+		while (!pending.empty()) writeOldest();
+	}
+};
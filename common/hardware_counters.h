@@ -0,0 +1,89 @@
+/*
+ * Hardware performance counters via perf_event_open (Linux).
+ * Description: Counts cycles, instructions, L1 data cache, last level
+ *   cache and data TLB read misses, branch misses and page faults of the
+ *   calling thread in user space. Together with the operation counts this
+ *   tells memory-bound solvers (misses per operation) from compute-bound
+ *   ones (instructions per cycle). Every event is opened on its own, so
+ *   an event the machine or a virtual machine does not support is just
+ *   unavailable. Counts are scaled up if the kernel multiplexed an event.
+ *   PhaseTimes reads the counters at every phase switch when one is
+ *   attached (see phase_times.h); runSolver does that for --perf=FILE.
+ *   Reading costs a system call per event, so this is a diagnostic mode,
+ *   not something to leave on.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+class HardwareCounters {
+public:
+	static const int NUM_EVENTS = 7;
+
+	static const char* name(int event) {
+		static const char* const NAMES[NUM_EVENTS] = {
+			"cycles", "instructions", "l1d_misses", "llc_misses", "dtlb_misses", "branch_misses", "page_faults",
+		};
+		return NAMES[event];
+	}
+
+private:
+	int fds[NUM_EVENTS];
+
+	static int open(uint32_t type, uint64_t config) {
+		perf_event_attr attr;
+		std::memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = type;
+		attr.config = config;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+		return (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+	}
+
+	static uint64_t cacheMiss(uint64_t cache) {
+		return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+	}
+
+public:
+	HardwareCounters() {
+		fds[0] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+		fds[1] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+		fds[2] = open(PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_L1D));
+		fds[3] = open(PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_LL));
+		fds[4] = open(PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_DTLB));
+		fds[5] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+		fds[6] = open(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+	}
+
+	HardwareCounters(const HardwareCounters&) = delete;
+	HardwareCounters& operator=(const HardwareCounters&) = delete;
+
+	~HardwareCounters() {
+		for (int fd : fds) {
+			if (fd >= 0) close(fd);
+		}
+	}
+
+	bool available(int event) const {
+		return fds[event] >= 0;
+	}
+
+	// Counts since construction; 0 for unavailable events.
+	void read(long long* values) const {
+		for (int i = 0; i < NUM_EVENTS; ++i) {
+			uint64_t data[3];
+			values[i] = 0;
+			if (fds[i] < 0 || ::read(fds[i], data, sizeof(data)) != (ssize_t) sizeof(data)) continue;
+			// data: value, time enabled, time running
+			if (data[2] == 0) continue;
+			values[i] = data[2] < data[1] ? (long long) ((double) data[0] * data[1] / data[2]) : (long long) data[0];
+		}
+	}
+};
@@ -0,0 +1,158 @@
+/*
+ * On-disk cache of generated instances.
+ * Description: An instance is determined by its InstanceKey, so it only
+ *   has to be generated once. cachedInstance returns the path of the
+ *   instance in the binary format (see binary_format.h), generating it
+ *   first if the cache does not have it. The file name is a hash of the
+ *   key, the binary format version and CACHE_VERSION. A new file is
+ *   written under a temporary name and renamed into place when complete,
+ *   so concurrent runs never see a partial instance. The writer holds a
+ *   lock on the temporary file; one left behind by a run that died (a
+ *   failed assertion in a generator, say) is no longer locked and is
+ *   removed by the next run that generates an instance.
+ *   The cache directory is $MAXFLOW_CACHE, else $XDG_CACHE_HOME/maxflow,
+ *   else $HOME/.cache/maxflow, else /tmp/maxflow-cache.
+ */
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "binary_format.h"
+#include "graph_sink.h"
+
+// Bump when a generator produces a different graph for the same key.
+const uint32_t CACHE_VERSION = 1;
+
+struct InstanceKey {
+	std::string generator;
+	int max_n, max_m, max_cap;
+	uint64_t seed;
+};
+
+inline std::string cacheDirectory() {
+	const char* dir = std::getenv("MAXFLOW_CACHE");
+	if (dir && *dir) return dir;
+	dir = std::getenv("XDG_CACHE_HOME");
+	if (dir && *dir) return std::string(dir) + "/maxflow";
+	dir = std::getenv("HOME");
+	if (dir && *dir) return std::string(dir) + "/.cache/maxflow";
+	return "/tmp/maxflow-cache";
+}
+
+inline std::string cachePath(const std::string& dir, const InstanceKey& key) {
+	std::string id = key.generator + ' ' + std::to_string(key.max_n) + ' ' + std::to_string(key.max_m) + ' ' +
+		std::to_string(key.max_cap) + ' ' + std::to_string(key.seed) + ' ' +
+		std::to_string(BINARY_VERSION) + ' ' + std::to_string(CACHE_VERSION);
+	// 64-bit FNV-1a
+	uint64_t hash = 14695981039346656037ULL;
+	for (char c : id) {
+		hash ^= (unsigned char) c;
+		hash *= 1099511628211ULL;
+	}
+	char hex[17];
+	std::snprintf(hex, sizeof(hex), "%016llx", (unsigned long long) hash);
+	return dir + '/' + key.generator + '-' + hex + ".bin";
+}
+
+// Creates dir and its parents as needed.
+inline void makeDirectories(const std::string& dir) {
+	for (size_t i = 1; i <= dir.size(); ++i) {
+		if (i < dir.size() && dir[i] != '/') continue;
+		std::string prefix = dir.substr(0, i);
+		if (mkdir(prefix.c_str(), 0777) != 0 && errno != EEXIST) {
+			throw std::runtime_error("cannot create directory " + prefix + ": " + std::strerror(errno));
+		}
+	}
+}
+
+// True if path holds an instance in the current binary format.
+inline bool isCached(const std::string& path) {
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) return false;
+	BinaryHeader h;
+	bool ok = read(fd, &h, sizeof(h)) == (ssize_t) sizeof(h) && isBinaryHeader((const char*) &h, sizeof(h)) && h.version == BINARY_VERSION;
+	close(fd);
+	return ok;
+}
+
+// Removes the temporary files in dir that no run holds a lock on.
+inline void removeStaleTemps(const std::string& dir) {
+	DIR* d = opendir(dir.c_str());
+	if (!d) return;
+	while (dirent* entry = readdir(d)) {
+		// written as <path>.XXXXXX, see cachedInstance
+		std::string name = entry->d_name;
+		if (name.size() < 11 || name.compare(name.size() - 11, 5, ".bin.") != 0) continue;
+		std::string temp = dir + '/' + name;
+		int fd = open(temp.c_str(), O_RDONLY);
+		if (fd < 0) continue;
+		if (flock(fd, LOCK_EX | LOCK_NB) == 0) unlink(temp.c_str());
+		close(fd);
+	}
+	closedir(d);
+}
+
+// generate(sink) has to produce the instance of key, see graph_sink.h.
+template<class Generate>
+std::string cachedInstance(const std::string& dir, const InstanceKey& key, Generate&& generate, int threads = 1) {
+	std::string path = cachePath(dir, key);
+	if (isCached(path)) return path;
+
+	makeDirectories(dir);
+	removeStaleTemps(dir);
+	std::string temp;
+	int fd;
+	while (true) {
+		temp = path + ".XXXXXX";
+		fd = mkstemp(&temp[0]);
+		if (fd < 0) {
+			throw std::runtime_error("cannot create " + temp + ": " + std::strerror(errno));
+		}
+		if (flock(fd, LOCK_EX) != 0) {
+			std::string error = std::strerror(errno);
+			close(fd);
+			unlink(temp.c_str());
+			throw std::runtime_error("cannot lock " + temp + ": " + error);
+		}
+		// Another run may have taken the file for stale before the lock.
+		struct stat st;
+		if (fstat(fd, &st) == 0 && st.st_nlink > 0) break;
+		close(fd);
+	}
+	try {
+		fchmod(fd, 0644);
+		FileSink sink(Format::Binary, threads, fd);
+		generate(sink);
+		sink.finish();
+		if (fsync(fd) != 0) {
+			throw std::runtime_error("cannot write " + temp + ": " + std::strerror(errno));
+		}
+		// Renamed while still locked, so it is never taken for stale.
+		if (std::rename(temp.c_str(), path.c_str()) != 0) {
+			throw std::runtime_error("cannot rename " + temp + ": " + std::strerror(errno));
+		}
+		int res = close(fd);
+		fd = -1;
+		if (res != 0) {
+			throw std::runtime_error("cannot write " + path + ": " + std::strerror(errno));
+		}
+	}
+	catch (...) {
+		if (fd >= 0) close(fd);
+		unlink(temp.c_str());
+		throw;
+	}
+	return path;
+}
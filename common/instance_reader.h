@@ -0,0 +1,284 @@
+/*
+ * Instance reader shared by all solvers.
+ * Description: Maps the input file into memory (or reads stdin in large
+ *   blocks when it is a pipe) and parses it in place. Understands both
+ *   input formats used in this repository:
+ *     n m                        p max [num_vertices] [num_edges]
+ *     from_1 to_1 cap_1          n [source_vertex] s
+ *     ...                        n [sink_vertex] t
+ *     from_m to_m cap_m          a [from_1] [to_1] [cap_1] ...
+ *   In the first format the source is 1 and the sink is n. Vertices are
+ *   converted to 0-based indices. Files in the binary format of
+ *   binary_format.h are recognized by their magic number and read
+ *   without any parsing.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "binary_format.h"
+
+class InstanceReader {
+private:
+	char* data;
+	size_t size, capacity;
+	bool mapped, dimacs, binary;
+	int vertex_width, cap_width;
+	long long max_cap;
+	const char* edgesBegin;
+
+	// Bytes after the end of the input are zero, so the scanners below
+	// never have to compare against the end pointer.
+	static const char* skipSpace(const char* p) {
+		while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') ++p;
+		return p;
+	}
+
+	static const char* skipWord(const char* p) {
+		while (*p && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') ++p;
+		return p;
+	}
+
+	static void skipLine(const char*& p) {
+		while (*p && *p != '\n') ++p;
+	}
+
+	// Reads an optionally signed number after whitespace. A negative
+	// capacity stays negative, so the solvers drop its edge.
+	static long long parseInt(const char*& p) {
+		p = skipSpace(p);
+		bool negative = (*p == '-');
+		if (*p == '-' || *p == '+') ++p;
+		if ((unsigned) (*p - '0') >= 10) {
+			if (!*p) throw std::runtime_error("unexpected end of input");
+			throw std::runtime_error(std::string("unexpected character '") + *p + "' in input");
+		}
+		long long x = 0;
+		while ((unsigned) (*p - '0') < 10) {
+			x = 10 * x + (*p++ - '0');
+		}
+		return negative ? -x : x;
+	}
+
+	void mapFile(int fd) {
+		struct stat st;
+		if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+			readAll(fd);
+			return;
+		}
+		long page = sysconf(_SC_PAGESIZE);
+		size = st.st_size;
+		capacity = (size / page + 1) * page;
+		// Reserve one zero page more than needed, then map the file over it.
+		void* area = mmap(nullptr, capacity, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (area == MAP_FAILED) {
+			readAll(fd);
+			return;
+		}
+		void* file = mmap(area, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0);
+		if (file == MAP_FAILED) {
+			munmap(area, capacity);
+			readAll(fd);
+			return;
+		}
+		madvise(area, size, MADV_SEQUENTIAL);
+		data = (char*) area;
+		mapped = true;
+	}
+
+	void readAll(int fd) {
+		size = 0;
+		capacity = 1 << 20;
+		data = (char*) std::malloc(capacity);
+		while (true) {
+			if (capacity - size < (1 << 20)) {
+				capacity *= 2;
+				data = (char*) std::realloc(data, capacity);
+			}
+			ssize_t got = read(fd, data + size, capacity - size - 1);
+			if (got < 0 && errno == EINTR) continue;
+			if (got < 0) throw std::runtime_error("cannot read input");
+			if (got == 0) break;
+			size += got;
+		}
+		data[size] = 0;
+	}
+
+	void parseHeader() {
+		binary = isBinaryHeader(data, size);
+		if (binary) {
+			BinaryHeader h;
+			std::memcpy(&h, data, sizeof(h));
+			if (h.version != BINARY_VERSION) {
+				throw std::runtime_error("unsupported binary format version " + std::to_string(h.version));
+			}
+			if (h.vertex_width != 2 && h.vertex_width != 4) throw std::runtime_error("invalid vertex width");
+			if (h.cap_width != 1 && h.cap_width != 2 && h.cap_width != 4 && h.cap_width != 8) {
+				throw std::runtime_error("invalid capacity width");
+			}
+			if (h.n > (uint32_t) std::numeric_limits<int>::max() || h.m > (uint64_t) std::numeric_limits<int>::max()) {
+				throw std::runtime_error("binary input too large");
+			}
+			if (h.s >= h.n || h.t >= h.n) throw std::runtime_error("source or sink out of range");
+			n = h.n;
+			m = h.m;
+			s = h.s;
+			t = h.t;
+			vertex_width = h.vertex_width;
+			cap_width = h.cap_width;
+			max_cap = h.max_cap;
+			edgesBegin = data + sizeof(h);
+			if ((size - sizeof(h)) / (2 * vertex_width + cap_width) < h.m) {
+				throw std::runtime_error("truncated binary input");
+			}
+			return;
+		}
+		const char* p = skipSpace(data);
+		dimacs = (*p == 'c' || *p == 'p');
+		if (!dimacs) {
+			n = parseInt(p);
+			m = parseInt(p);
+			if (n < 1) throw std::runtime_error("instance without vertices");
+			s = 0;
+			t = n - 1;
+			max_cap = -1;
+			edgesBegin = p;
+			return;
+		}
+		n = m = 0;
+		s = t = -1;
+		while (*(p = skipSpace(p)) && *p != 'a') {
+			if (*p == 'p') {
+				// p max n m
+				p = skipWord(skipSpace(p + 1));
+				n = parseInt(p);
+				m = parseInt(p);
+			}
+			else if (*p == 'n') {
+				++p;
+				int v = parseInt(p) - 1;
+				while (*p == ' ' || *p == '\t') ++p;
+				if (*p == 's') s = v;
+				if (*p == 't') t = v;
+			}
+			skipLine(p);
+		}
+		if (s < 0 || t < 0) {
+			throw std::runtime_error("DIMACS input without source or sink");
+		}
+		if (s >= n || t >= n) throw std::runtime_error("source or sink out of range");
+		max_cap = -1;
+		edgesBegin = p;
+	}
+
+	// from and to are 0-based.
+	void checkEdge(long long from, long long to) const {
+		if (from < 0 || from >= n || to < 0 || to >= n) {
+			throw std::runtime_error("edge " + std::to_string(from + 1) + " -> " + std::to_string(to + 1) + " has a vertex outside 1.." + std::to_string(n));
+		}
+	}
+
+	template<int VW, int CW, class F>
+	void readBinaryEdges(F& addEdge) const {
+		const char* p = edgesBegin;
+		for (int i = 0; i < m; ++i, p += 2 * VW + CW) {
+			long long from = unpackInt(p, VW), to = unpackInt(p + VW, VW);
+			checkEdge(from, to);
+			addEdge((int) from, (int) to, (long long) unpackInt(p + 2 * VW, CW));
+		}
+	}
+
+	template<int VW, class F>
+	void readBinaryEdges(F& addEdge) const {
+		switch (cap_width) {
+			case 1: readBinaryEdges<VW, 1>(addEdge); break;
+			case 2: readBinaryEdges<VW, 2>(addEdge); break;
+			case 4: readBinaryEdges<VW, 4>(addEdge); break;
+			case 8: readBinaryEdges<VW, 8>(addEdge); break;
+			default: throw std::runtime_error("invalid capacity width");
+		}
+	}
+
+public:
+	int n, m, s, t;
+
+	// Reads from the given file, or from stdin if path is null.
+	InstanceReader(const char* path = nullptr) : data(nullptr), size(0), capacity(0), mapped(false) {
+		int fd = 0;
+		if (path) {
+			fd = open(path, O_RDONLY);
+			if (fd < 0) {
+				throw std::runtime_error(std::string("cannot open ") + path + ": " + std::strerror(errno));
+			}
+		}
+		mapFile(fd);
+		if (path) close(fd);
+		parseHeader();
+	}
+
+	InstanceReader(const InstanceReader&) = delete;
+	InstanceReader& operator=(const InstanceReader&) = delete;
+
+	~InstanceReader() {
+		if (mapped) munmap(data, capacity);
+		else std::free(data);
+	}
+
+	// Calls addEdge(from, to, cap) for every edge, in input order.
+	template<class F>
+	void readEdges(F&& addEdge) const {
+		if (binary) {
+			if (vertex_width == 2) readBinaryEdges<2>(addEdge);
+			else if (vertex_width == 4) readBinaryEdges<4>(addEdge);
+			else throw std::runtime_error("invalid vertex width");
+			return;
+		}
+		const char* p = edgesBegin;
+		if (!dimacs) {
+			for (int i = 0; i < m; ++i) {
+				p = skipSpace(p);
+				if (!*p) break;
+				long long from = parseInt(p) - 1;
+				long long to = parseInt(p) - 1;
+				long long cap = parseInt(p);
+				checkEdge(from, to);
+				addEdge((int) from, (int) to, cap);
+			}
+			return;
+		}
+		while (*(p = skipSpace(p))) {
+			if (*p == 'a') {
+				++p;
+				long long from = parseInt(p) - 1;
+				long long to = parseInt(p) - 1;
+				long long cap = parseInt(p);
+				checkEdge(from, to);
+				addEdge((int) from, (int) to, cap);
+			}
+			skipLine(p);
+		}
+	}
+
+	// Bound on all capacities: taken from the header of binary inputs,
+	// found by a scan over the edges otherwise.
+	long long maxCap() {
+		if (max_cap < 0) {
+			max_cap = 0;
+			readEdges([&](int, int, long long cap) {
+				max_cap = std::max(max_cap, cap);
+			});
+		}
+		return max_cap;
+	}
+};
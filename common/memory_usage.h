@@ -0,0 +1,35 @@
+/*
+ * Memory use of a solve.
+ * Description: The arena tallies the bytes of every solve by use (see
+ *   arena.h): the arcs of the residual graph and their offsets, per-vertex
+ *   state, and queues and buckets. Together with the peak resident set
+ *   size of the process, which also covers the input and the C++ runtime,
+ *   and the bytes per input edge, this predicts the memory of an instance
+ *   from its size. runSolver writes it for --memory=FILE.
+ */
+#pragma once
+
+#include <cstdio>
+
+#include <sys/resource.h>
+
+#include "arena.h"
+
+// Peak resident set size of the process in bytes.
+inline long long peakRss() {
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+	// Linux reports kilobytes.
+	return usage.ru_maxrss * 1024LL;
+}
+
+// Writes the memory use of a solve with m input edges as one line of JSON.
+inline void writeMemory(FILE* out, const Arena& arena, long long m) {
+	for (int i = 0; i < NUM_USES; ++i) {
+		std::fprintf(out, "%s\"%s_bytes\": %zu", i ? ", " : "{", useName((Use) i), arena.allocated((Use) i));
+	}
+	long long rss = peakRss();
+	double edges = m > 0 ? (double) m : 1;
+	std::fprintf(out, ", \"allocated_bytes\": %zu, \"reserved_bytes\": %zu, \"bytes_per_edge\": %.2f, \"peak_rss_bytes\": %lld, \"peak_rss_per_edge\": %.2f}\n",
+		arena.allocated(), arena.capacity(), arena.allocated() / edges, rss, rss / edges);
+}
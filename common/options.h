@@ -0,0 +1,61 @@
+/*
+ * Command line options of the form --name=value.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Returns the value of --name=value, or fallback if the option is absent.
+inline const char* getOption(int argc, char* argv[], const char* name, const char* fallback = nullptr) {
+	size_t len = std::strlen(name);
+	for (int i = 1; i < argc; ++i) {
+		const char* arg = argv[i];
+		if (std::strncmp(arg, "--", 2) == 0 && std::strncmp(arg + 2, name, len) == 0 && arg[2 + len] == '=') {
+			return arg + 3 + len;
+		}
+	}
+	return fallback;
+}
+
+// Returns whether the flag --name is given.
+inline bool hasFlag(int argc, char* argv[], const char* name) {
+	for (int i = 1; i < argc; ++i) {
+		if (std::strncmp(argv[i], "--", 2) == 0 && std::strcmp(argv[i] + 2, name) == 0) return true;
+	}
+	return false;
+}
+
+// Returns the first argument that is not an option, or nullptr.
+inline const char* getPositional(int argc, char* argv[]) {
+	for (int i = 1; i < argc; ++i) {
+		if (std::strncmp(argv[i], "--", 2) != 0) return argv[i];
+	}
+	return nullptr;
+}
+
+// Splits a comma-separated option value such as --solvers=a,b into its
+// items, skipping empty ones.
+inline std::vector<std::string> split(const std::string& list) {
+	std::vector<std::string> items;
+	size_t begin = 0;
+	while (begin <= list.size()) {
+		size_t end = list.find(',', begin);
+		if (end == std::string::npos) end = list.size();
+		if (end > begin) items.push_back(list.substr(begin, end - begin));
+		begin = end + 1;
+	}
+	return items;
+}
+
+// Returns the value of --seed=value, or a seed taken from the clock if the
+// option is absent. Runs with equal seeds make equal random choices.
+inline uint64_t getSeed(int argc, char* argv[]) {
+	const char* seed = getOption(argc, argv, "seed");
+	if (seed) return std::strtoull(seed, nullptr, 10);
+	return std::chrono::steady_clock::now().time_since_epoch().count();
+}
@@ -0,0 +1,141 @@
+/*
+ * Wall-clock time per phase of a run.
+ * Description: Every solver has a member times of type PhaseTimes that
+ *   splits the time of flow() into phases (Dinic: bfs and dfs, HLPP:
+ *   preprocess and discharge, ...). A ScopedPhase makes its phase the
+ *   current one until it goes out of scope. Time is always charged to the
+ *   innermost current phase, so nested phases are exclusive and the
+ *   phases add up to the measured total. A switch costs one steady_clock
+ *   read, and solvers only switch between phases, not per operation, so
+ *   the timers stay on in every build. runSolver writes the times with
+ *   those of reading and building the graph when given --times=FILE
+ *   (see solver_main.h). With hardware counters attached, every phase
+ *   also gets the events counted while it was current.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "hardware_counters.h"
+
+class PhaseTimes {
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Phase {
+		std::string name;
+		long long calls;
+		Clock::duration total;
+		long long events[HardwareCounters::NUM_EVENTS];
+	};
+
+	std::vector<Phase> phases;
+	int current = -1;
+	Clock::time_point last;
+	const HardwareCounters* hardware = nullptr;
+	long long last_events[HardwareCounters::NUM_EVENTS];
+
+	void charge() {
+		Clock::time_point now = Clock::now();
+		if (current >= 0) phases[current].total += now - last;
+		last = now;
+		if (hardware) {
+			long long events[HardwareCounters::NUM_EVENTS];
+			hardware->read(events);
+			for (int i = 0; i < HardwareCounters::NUM_EVENTS; ++i) {
+				if (current >= 0) phases[current].events[i] += events[i] - last_events[i];
+				last_events[i] = events[i];
+			}
+		}
+	}
+
+public:
+	// Index of the phase with this name, added if it is new.
+	int phase(const std::string& name) {
+		for (int i = 0; i < (int) phases.size(); ++i) {
+			if (phases[i].name == name) return i;
+		}
+		phases.push_back({name, 0, Clock::duration::zero(), {}});
+		return (int) phases.size() - 1;
+	}
+
+	// Makes phase current and returns the phase it replaces (-1: none).
+	int enter(int phase) {
+		charge();
+		int previous = current;
+		current = phase;
+		phases[phase].calls += 1;
+		return previous;
+	}
+
+	void leave(int previous) {
+		charge();
+		current = previous;
+	}
+
+	// Counts hardware events per phase from now on (nullptr: stop).
+	void attach(const HardwareCounters* _hardware) {
+		hardware = _hardware;
+		if (hardware) hardware->read(last_events);
+	}
+
+	const HardwareCounters* attached() const {
+		return hardware;
+	}
+
+	// Adds the phases of other, e.g. those of a solver to those of the input.
+	void append(const PhaseTimes& other) {
+		for (const Phase& p : other.phases) {
+			Phase& mine = phases[phase(p.name)];
+			mine.calls += p.calls;
+			mine.total += p.total;
+			for (int i = 0; i < HardwareCounters::NUM_EVENTS; ++i) mine.events[i] += p.events[i];
+		}
+	}
+
+	// Calls f(name, calls, seconds, events) for every phase, in order of
+	// creation. events has HardwareCounters::NUM_EVENTS entries.
+	template<class F>
+	void forEach(F&& f) const {
+		for (const Phase& p : phases) {
+			f(p.name.c_str(), p.calls, std::chrono::duration<double>(p.total).count(), p.events);
+		}
+	}
+};
+
+class ScopedPhase {
+private:
+	PhaseTimes& times;
+	int previous;
+
+public:
+	ScopedPhase(PhaseTimes& _times, int phase) : times(_times), previous(_times.enter(phase)) {}
+
+	ScopedPhase(const ScopedPhase&) = delete;
+	ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+	~ScopedPhase() {
+		times.leave(previous);
+	}
+};
+
+// Writes the phases as one line of JSON: {"name": {"calls": c, "seconds": s}, ...}.
+// With hardware counters attached, every phase also has a field per event,
+// null if the event is unavailable.
+inline void writeTimes(FILE* out, const PhaseTimes& times) {
+	const HardwareCounters* hardware = times.attached();
+	const char* separator = "{";
+	times.forEach([&](const char* name, long long calls, double seconds, const long long* events) {
+		std::fprintf(out, "%s\"%s\": {\"calls\": %lld, \"seconds\": %.9f", separator, name, calls, seconds);
+		for (int i = 0; hardware && i < HardwareCounters::NUM_EVENTS; ++i) {
+			if (hardware->available(i)) std::fprintf(out, ", \"%s\": %lld", HardwareCounters::name(i), events[i]);
+			else std::fprintf(out, ", \"%s\": null", HardwareCounters::name(i));
+		}
+		std::fprintf(out, "}");
+		separator = ", ";
+	});
+	std::fprintf(out, "%s}\n", *separator == '{' ? "{" : "");
+}
@@ -0,0 +1,194 @@
+/*
+ * Live progress of long solves.
+ * Description: Every solver has a member progress of type Progress and
+ *   calls progress.step(flow) whenever it completes a phase: an augmenting
+ *   path search, a blocking flow or a discharge. flow is the flow value
+ *   so far (for push-relabel, the excess that reached t). Both values are
+ *   relaxed atomics with a single writer, so a step is a few plain stores
+ *   in the hot loop. ProgressReporter reads them, and the operation counts
+ *   when MAXFLOW_COUNTERS is defined (see counters.h), from a background
+ *   thread and writes a report every interval and a final one when it is
+ *   destroyed, either as JSON lines or in the Prometheus text format. The
+ *   target is a file or, as unix:PATH, a listening Unix stream socket.
+ *   JSON lines are appended to a file; Prometheus reports replace it, so
+ *   it can be read by a textfile collector. runSolver starts a reporter
+ *   for --progress=TARGET (see solver_main.h).
+ */
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "counters.h"
+
+class Progress {
+private:
+	std::atomic<long long> flow_value{0};
+	std::atomic<long long> phase_count{0};
+
+public:
+	void step(long long flow) {
+		flow_value.store(flow, std::memory_order_relaxed);
+		phase_count.store(phase_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	long long flow() const {
+		return flow_value.load(std::memory_order_relaxed);
+	}
+
+	long long phases() const {
+		return phase_count.load(std::memory_order_relaxed);
+	}
+};
+
+enum class ProgressFormat { Json, Prometheus };
+
+struct ProgressOptions {
+	// File path or unix:PATH; nullptr disables reporting.
+	const char* target = nullptr;
+	ProgressFormat format = ProgressFormat::Json;
+	double interval = 10;
+	// Solver name for the reports.
+	std::string solver;
+};
+
+class ProgressReporter {
+private:
+	using Clock = std::chrono::steady_clock;
+
+	const Progress& progress;
+	const OperationCounts& counts;
+	ProgressOptions options;
+	Clock::time_point start;
+	int socket_fd;
+	std::mutex mutex;
+	std::condition_variable wake;
+	bool stopping;
+	std::thread thread;
+
+	std::string json(double elapsed, bool done) const {
+		char head[256];
+		std::snprintf(head, sizeof(head), "{\"solver\": \"%s\", \"elapsed_seconds\": %.3f, \"flow\": %lld, \"phases\": %lld",
+			options.solver.c_str(), elapsed, progress.flow(), progress.phases());
+		std::string text = head;
+		if (COUNTERS_ENABLED) {
+			const char* separator = ", \"counts\": {";
+			counts.forEach([&](const char* name, long long value) {
+				text += std::string(separator) + '"' + name + "\": " + std::to_string(value);
+				separator = ", ";
+			});
+			text += '}';
+		}
+		text += done ? ", \"done\": true}\n" : ", \"done\": false}\n";
+		return text;
+	}
+
+	std::string prometheus(double elapsed, bool done) const {
+		std::string label = "{solver=\"" + options.solver + "\"}";
+		char values[512];
+		std::snprintf(values, sizeof(values),
+			"# TYPE maxflow_elapsed_seconds gauge\nmaxflow_elapsed_seconds%s %.3f\n"
+			"# TYPE maxflow_flow gauge\nmaxflow_flow%s %lld\n"
+			"# TYPE maxflow_phases_total counter\nmaxflow_phases_total%s %lld\n"
+			"# TYPE maxflow_done gauge\nmaxflow_done%s %d\n",
+			label.c_str(), elapsed, label.c_str(), progress.flow(), label.c_str(), progress.phases(), label.c_str(), done ? 1 : 0);
+		std::string text = values;
+		if (COUNTERS_ENABLED) {
+			text += "# TYPE maxflow_operations_total counter\n";
+			counts.forEach([&](const char* name, long long value) {
+				text += "maxflow_operations_total{solver=\"" + options.solver + "\",operation=\"" + name + "\"} " + std::to_string(value) + '\n';
+			});
+		}
+		return text;
+	}
+
+	// A closed socket must not kill the solver with SIGPIPE, hence send().
+	void writeAll(int fd, const std::string& text) {
+		size_t done = 0;
+		while (done < text.size()) {
+			ssize_t n = fd == socket_fd ? send(fd, text.data() + done, text.size() - done, MSG_NOSIGNAL)
+				: ::write(fd, text.data() + done, text.size() - done);
+			if (n <= 0) return;
+			done += n;
+		}
+	}
+
+	void report(bool done) {
+		double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+		bool as_json = options.format == ProgressFormat::Json;
+		std::string text = as_json ? json(elapsed, done) : prometheus(elapsed, done);
+		if (socket_fd >= 0) {
+			writeAll(socket_fd, as_json ? text : text + '\n');
+		}
+		else if (as_json) {
+			int fd = open(options.target, O_WRONLY | O_CREAT | O_APPEND, 0644);
+			if (fd < 0) return;
+			writeAll(fd, text);
+			close(fd);
+		}
+		else {
+			// Replace the file at once, so readers never see half a report.
+			std::string temp = std::string(options.target) + ".tmp";
+			int fd = open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+			if (fd < 0) return;
+			writeAll(fd, text);
+			close(fd);
+			std::rename(temp.c_str(), options.target);
+		}
+	}
+
+	void run() {
+		std::unique_lock<std::mutex> lock(mutex);
+		auto interval = std::chrono::duration<double>(options.interval);
+		while (!wake.wait_for(lock, interval, [&] { return stopping; })) {
+			report(false);
+		}
+	}
+
+public:
+	ProgressReporter(const Progress& _progress, const OperationCounts& _counts, const ProgressOptions& _options) :
+		progress(_progress), counts(_counts), options(_options), start(Clock::now()), socket_fd(-1), stopping(false) {
+		if (std::strncmp(options.target, "unix:", 5) == 0) {
+			sockaddr_un address;
+			std::memset(&address, 0, sizeof(address));
+			address.sun_family = AF_UNIX;
+			const char* path = options.target + 5;
+			if (std::strlen(path) >= sizeof(address.sun_path)) throw std::runtime_error(std::string("socket path too long: ") + path);
+			std::strcpy(address.sun_path, path);
+			socket_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+			if (socket_fd < 0 || connect(socket_fd, (sockaddr*) &address, sizeof(address)) != 0) {
+				std::string error = std::strerror(errno);
+				if (socket_fd >= 0) close(socket_fd);
+				throw std::runtime_error(std::string("cannot connect to ") + path + ": " + error);
+			}
+		}
+		thread = std::thread([this] { run(); });
+	}
+
+	ProgressReporter(const ProgressReporter&) = delete;
+	ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+	~ProgressReporter() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		wake.notify_one();
+		thread.join();
+		report(true);
+		if (socket_fd >= 0) close(socket_fd);
+	}
+};
@@ -0,0 +1,149 @@
+/*
+ * Residual graph shared by all solvers.
+ * Description: Compressed sparse row layout: the arcs leaving vertex v
+ *   are arcs[first[v]] .. arcs[first[v + 1] - 1], and arcs[e.rev] is the
+ *   reverse arc of e. Both arrays live in the solve's arena. build()
+ *   keeps the order in which each vertex sees its arcs (some generators
+ *   rely on the solvers scanning arcs in input order).
+ *   There are two ways to fill the graph:
+ *     - Call addEdge for every edge, then build(). Edges are buffered
+ *       until build() lays them out.
+ *     - When the edges can be produced twice, call startCount(), add all
+ *       edges, call startFill(), add the same edges again, then build().
+ *       The first pass only counts degrees and the second writes every
+ *       arc straight into its final slot, so nothing is buffered.
+ *   Cap is the capacity type; arcs are packed, so narrow capacities fit
+ *   more arcs into a cache line (9 bytes per arc for uint8_t, 16 for
+ *   int64_t). The residual capacity of an arc never exceeds the largest
+ *   input capacity, so Cap only has to hold that.
+ */
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "arena.h"
+
+#pragma pack(push, 1)
+template<class Cap>
+struct Arc {
+	int to, rev;
+	Cap cap;
+};
+#pragma pack(pop)
+
+template<class Cap>
+struct ResidualGraph {
+	struct Edge {
+		int from, to;
+		Cap cap;
+	};
+
+	struct ArcRange {
+		Arc<Cap> *first, *last;
+		Arc<Cap>* begin() const { return first; }
+		Arc<Cap>* end() const { return last; }
+	};
+
+	enum class Pass {
+		Buffer, Count, Fill, Built
+	};
+
+	const int n;
+	Arena& arena;
+	int* first;
+	Arc<Cap>* arcs;
+	int num_arcs;
+	std::vector<Edge> edges;
+	Pass pass;
+	// If set, receives the arc of every edge as it is placed, and follows
+	// the arcs when they move (see flow_recovery.h).
+	std::vector<int>* edge_arcs;
+
+	ResidualGraph(int _n, Arena& _arena) : n(_n), arena(_arena),
+		first(arena.allocate<int>(n + 1, Use::Arcs)), arcs(nullptr), num_arcs(0), pass(Pass::Buffer), edge_arcs(nullptr) {}
+
+	void addEdge(int from, int to, Cap cap) {
+		if (pass == Pass::Buffer) {
+			edges.push_back({from, to, cap});
+		}
+		else if (pass == Pass::Count) {
+			first[from + 1] += 1;
+			first[to + 1] += 1;
+		}
+		else {
+			// first[v] is the next free slot of v during the fill pass
+			int a = first[from]++;
+			int b = first[to]++;
+			arcs[a] = {to, b, cap};
+			arcs[b] = {from, a, 0};
+			if (edge_arcs) edge_arcs->push_back(a);
+		}
+	}
+
+	void startCount() {
+		std::fill(first, first + n + 1, 0);
+		pass = Pass::Count;
+	}
+
+	void startFill() {
+		std::partial_sum(first, first + n + 1, first);
+		num_arcs = first[n];
+		arcs = arena.allocate<Arc<Cap>>(num_arcs, Use::Arcs);
+		pass = Pass::Fill;
+	}
+
+	void build() {
+		if (pass == Pass::Built) return;
+		if (pass == Pass::Buffer) {
+			startCount();
+			for (const Edge& e : edges) addEdge(e.from, e.to, e.cap);
+			startFill();
+			for (const Edge& e : edges) addEdge(e.from, e.to, e.cap);
+			std::vector<Edge>().swap(edges);
+		}
+		// after the fill pass first[v] is where v + 1 starts
+		std::copy_backward(first, first + n, first + n + 1);
+		first[0] = 0;
+		pass = Pass::Built;
+	}
+
+	ArcRange out(int v) {
+		return {arcs + first[v], arcs + first[v + 1]};
+	}
+
+	Cap maxCap() const {
+		Cap res = 0;
+		for (int i = 0; i < num_arcs; ++i) {
+			res = std::max<Cap>(res, arcs[i].cap);
+		}
+		return res;
+	}
+
+	// Randomly permutes the arcs of every vertex, keeping rev consistent.
+	// The temporaries stay in the arena until it is reset.
+	template<class Rng>
+	void shuffleArcs(Rng& rng) {
+		int* order = arena.allocate<int>(num_arcs, Use::Arcs);
+		int* where = arena.allocate<int>(num_arcs, Use::Arcs);
+		std::iota(order, order + num_arcs, 0);
+		for (int v = 0; v < n; ++v) {
+			std::shuffle(order + first[v], order + first[v + 1], rng);
+		}
+		for (int i = 0; i < num_arcs; ++i) {
+			where[order[i]] = i;
+		}
+		Arc<Cap>* shuffled = arena.allocate<Arc<Cap>>(num_arcs, Use::Arcs);
+		for (int i = 0; i < num_arcs; ++i) {
+			shuffled[i] = arcs[order[i]];
+			shuffled[i].rev = where[shuffled[i].rev];
+		}
+		std::copy(shuffled, shuffled + num_arcs, arcs);
+		if (edge_arcs) {
+			for (int& a : *edge_arcs) {
+				if (a >= 0) a = where[a];
+			}
+		}
+	}
+};
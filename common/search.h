@@ -0,0 +1,32 @@
+/*
+ * Binary search over monotone predicates.
+ * Description: The generators pick their parameters as the largest (or
+ *   smallest) values that satisfy size constraints. Those constraints are
+ *   monotone, so the values are found in O(log(hi - lo)) evaluations
+ *   instead of by stepping through every candidate.
+ */
+#pragma once
+
+// Smallest x in [lo, hi] with ok(x), or hi + 1 if there is none.
+// ok has to be false up to some point and true from there on.
+template<class F>
+long long firstTrue(long long lo, long long hi, F&& ok) {
+	while (lo <= hi) {
+		long long mid = lo + (hi - lo) / 2;
+		if (ok(mid)) hi = mid - 1;
+		else lo = mid + 1;
+	}
+	return lo;
+}
+
+// Largest x in [lo, hi] with ok(x), or lo - 1 if there is none.
+// ok has to be true up to some point and false from there on.
+template<class F>
+long long lastTrue(long long lo, long long hi, F&& ok) {
+	while (lo <= hi) {
+		long long mid = lo + (hi - lo) / 2;
+		if (ok(mid)) lo = mid + 1;
+		else hi = mid - 1;
+	}
+	return hi;
+}
@@ -0,0 +1,186 @@
+/*
+ * Entry point shared by all solvers.
+ * Description: Reads the instance named on the command line (or stdin),
+ *   instantiates the solver with the narrowest capacity type that holds
+ *   every capacity of the instance, and prints the maximum flow value.
+ *   The input stays mapped, so the graph is built in two passes over it
+ *   (see residual_graph.h) and never buffers the edge list.
+ *   A missing or malformed instance is reported on stderr with status 1.
+ *   configure(g) is called on the solver before the graph is read, for
+ *   settings such as a seed. With MAXFLOW_COUNTERS defined, the operation
+ *   counts of the solver follow on stderr (see counters.h). --times=FILE
+ *   writes the time spent reading, counting degrees, filling arcs and
+ *   building the graph, and in each phase of the solver, as one line of
+ *   JSON to FILE ("-" for stderr, see phase_times.h). --perf=FILE does the
+ *   same with hardware counters attached (see hardware_counters.h) and,
+ *   with MAXFLOW_COUNTERS defined, adds a line with the operation counts.
+ *   --memory=FILE writes the bytes allocated per use, the bytes per input
+ *   edge and the peak resident set size (see memory_usage.h).
+ *   --progress=TARGET reports the progress of the solve every
+ *   --progress-interval seconds (default 10) to a file or unix:PATH, as
+ *   --progress-format=json lines (default) or prometheus text (see
+ *   progress.h). --flows=FILE writes the flow on every input edge, one per
+ *   line in input order, after turning the preflow of a push-relabel
+ *   solver into a flow (see flow_recovery.h).
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "arena.h"
+#include "counters.h"
+#include "flow_recovery.h"
+#include "hardware_counters.h"
+#include "instance_reader.h"
+#include "memory_usage.h"
+#include "options.h"
+#include "phase_times.h"
+#include "progress.h"
+
+// Opens the file of a report, "-" meaning stderr. Returns nullptr on error.
+inline FILE* openReport(const char* path) {
+	if (std::strcmp(path, "-") == 0) return stderr;
+	FILE* out = std::fopen(path, "w");
+	if (!out) std::perror(path);
+	return out;
+}
+
+inline void closeReport(FILE* out) {
+	if (out != stderr) std::fclose(out);
+}
+
+// Returns the operation counts of the solver.
+template<class Solver, class Configure>
+OperationCounts solve(InstanceReader& in, Arena& arena, Configure& configure, PhaseTimes& times, const ProgressOptions& progress, FILE* flows) {
+	Solver g(in.n, in.s, in.t, arena);
+	configure(g);
+	g.times.attach(times.attached());
+
+	// Drops the edges without capacity before an unsigned Cap could wrap
+	// a negative one.
+	auto addEdge = [&](int from, int to, long long cap) {
+		if (cap >= 1) g.addEdge(from, to, cap);
+	};
+	std::vector<int> edge_arcs;
+	{
+		ScopedPhase phase(times, times.phase("count"));
+		g.adj.startCount();
+		in.readEdges(addEdge);
+	}
+	{
+		ScopedPhase phase(times, times.phase("fill"));
+		g.adj.startFill();
+		if (flows) {
+			g.adj.edge_arcs = &edge_arcs;
+			in.readEdges([&](int from, int to, long long cap) {
+				size_t placed = edge_arcs.size();
+				addEdge(from, to, cap);
+				if (edge_arcs.size() == placed) edge_arcs.push_back(-1);
+			});
+		}
+		else in.readEdges(addEdge);
+	}
+	{
+		ScopedPhase phase(times, times.phase("build"));
+		g.adj.build();
+	}
+
+	long long flow;
+	{
+		std::unique_ptr<ProgressReporter> reporter;
+		if (progress.target) {
+			// Losing the telemetry must not lose the solve.
+			try {
+				reporter.reset(new ProgressReporter(g.progress, g.counts, progress));
+			}
+			catch (const std::runtime_error& e) {
+				std::fprintf(stderr, "no progress reports: %s\n", e.what());
+			}
+		}
+		// Time of flow() outside the solver's own phases.
+		ScopedPhase phase(g.times, g.times.phase("flow"));
+		flow = g.flow();
+	}
+	times.append(g.times);
+
+	std::cout << flow << '\n';
+	if (COUNTERS_ENABLED) writeCounts(stderr, g.counts);
+	if (flows) {
+		ScopedPhase phase(times, times.phase("recover"));
+		recoverFlow(g.adj, edge_arcs, g.s, g.t);
+		writeFlows(flows, g.adj, edge_arcs);
+	}
+	return g.counts;
+}
+
+template<template<class> class Solver, class Configure>
+int runSolver(int argc, char* argv[], Configure configure) {
+	ProgressOptions progress;
+	progress.target = getOption(argc, argv, "progress");
+	if (std::strcmp(getOption(argc, argv, "progress-format", "json"), "prometheus") == 0) progress.format = ProgressFormat::Prometheus;
+	progress.interval = std::atof(getOption(argc, argv, "progress-interval", "10"));
+	const char* name = std::strrchr(argv[0], '/');
+	progress.solver = name ? name + 1 : argv[0];
+
+	PhaseTimes times;
+	const char* perf_path = getOption(argc, argv, "perf");
+	std::unique_ptr<HardwareCounters> hardware;
+	if (perf_path) {
+		hardware.reset(new HardwareCounters());
+		if (!hardware->available(0)) std::fprintf(stderr, "perf_event_open: hardware events are unavailable (see /proc/sys/kernel/perf_event_paranoid)\n");
+		times.attach(hardware.get());
+	}
+	try {
+		int previous = times.enter(times.phase("read"));
+		InstanceReader in(getPositional(argc, argv));
+		Arena arena;
+		long long max_cap = in.maxCap();
+		times.leave(previous);
+
+		FILE* flows = nullptr;
+		if (const char* flows_path = getOption(argc, argv, "flows")) {
+			flows = openReport(flows_path);
+			if (!flows) return 1;
+		}
+		OperationCounts counts;
+		if (max_cap <= std::numeric_limits<uint8_t>::max()) counts = solve<Solver<uint8_t>>(in, arena, configure, times, progress, flows);
+		else if (max_cap <= std::numeric_limits<uint16_t>::max()) counts = solve<Solver<uint16_t>>(in, arena, configure, times, progress, flows);
+		else if (max_cap <= std::numeric_limits<int32_t>::max()) counts = solve<Solver<int32_t>>(in, arena, configure, times, progress, flows);
+		else counts = solve<Solver<int64_t>>(in, arena, configure, times, progress, flows);
+		if (flows) closeReport(flows);
+
+		const char* path = perf_path ? perf_path : getOption(argc, argv, "times");
+		if (path) {
+			FILE* out = openReport(path);
+			if (!out) return 1;
+			writeTimes(out, times);
+			// On stderr, solve() has written the counts already.
+			if (perf_path && COUNTERS_ENABLED && out != stderr) writeCounts(out, counts);
+			closeReport(out);
+		}
+		if (const char* memory_path = getOption(argc, argv, "memory")) {
+			FILE* out = openReport(memory_path);
+			if (!out) return 1;
+			writeMemory(out, arena, in.m);
+			closeReport(out);
+		}
+		return 0;
+	}
+	catch (const std::exception& e) {
+		std::fprintf(stderr, "%s\n", e.what());
+		return 1;
+	}
+}
+
+template<template<class> class Solver>
+int runSolver(int argc, char* argv[]) {
+	return runSolver<Solver>(argc, argv, [](auto&) {});
+}
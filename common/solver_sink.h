@@ -0,0 +1,123 @@
+/*
+ * Sink that feeds a generated graph straight into a solver.
+ * Description: Lets a process generate an instance and solve it without
+ *   writing or parsing it. The residual graph is built in the same two
+ *   passes as for a mapped input file (see residual_graph.h): the
+ *   generator runs once to count degrees and once more to place the arcs,
+ *   so it has to produce the same graph both times (fixed seed). The
+ *   capacity type is chosen from the max_cap passed to begin(), like
+ *   runSolver does for files. configure(g) is called on the solver right
+ *   after it is constructed. SizeRecorder passes a graph on to a sink and
+ *   keeps its size.
+ */
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <variant>
+
+#include "arena.h"
+#include "counters.h"
+#include "phase_times.h"
+
+template<template<class> class Solver, class Configure>
+class SolverSink {
+private:
+	Arena& arena;
+	Configure configure;
+	std::variant<std::monostate, Solver<uint8_t>, Solver<uint16_t>, Solver<int32_t>, Solver<int64_t>> solver;
+	int passes;
+
+	template<class F>
+	void apply(F&& f) {
+		std::visit([&](auto& g) {
+			if constexpr (!std::is_same<std::decay_t<decltype(g)>, std::monostate>::value) f(g);
+		}, solver);
+	}
+
+public:
+	SolverSink(Arena& _arena, Configure _configure) : arena(_arena), configure(_configure), passes(0) {}
+
+	void begin(long long n, long long, int s, int t, long long max_cap) {
+		passes += 1;
+		if (passes == 1) {
+			if (max_cap <= std::numeric_limits<uint8_t>::max()) solver.template emplace<Solver<uint8_t>>(n, s - 1, t - 1, arena);
+			else if (max_cap <= std::numeric_limits<uint16_t>::max()) solver.template emplace<Solver<uint16_t>>(n, s - 1, t - 1, arena);
+			else if (max_cap <= std::numeric_limits<int32_t>::max()) solver.template emplace<Solver<int32_t>>(n, s - 1, t - 1, arena);
+			else solver.template emplace<Solver<int64_t>>(n, s - 1, t - 1, arena);
+			apply([&](auto& g) {
+				configure(g);
+				g.adj.startCount();
+			});
+		}
+		else if (passes == 2) {
+			apply([](auto& g) { g.adj.startFill(); });
+		}
+		else {
+			throw std::logic_error("SolverSink takes exactly two passes");
+		}
+	}
+
+	void edge(int from, int to, long long cap) {
+		apply([&](auto& g) { g.addEdge(from - 1, to - 1, cap); });
+	}
+
+	// Finishes the residual graph; flow() does it too if needed.
+	void build() {
+		apply([](auto& g) { g.adj.build(); });
+	}
+
+	long long flow() {
+		long long res = 0;
+		apply([&](auto& g) {
+			g.adj.build();
+			res = g.flow();
+		});
+		return res;
+	}
+
+	OperationCounts counts() {
+		OperationCounts res;
+		apply([&](auto& g) { res = g.counts; });
+		return res;
+	}
+
+	PhaseTimes times() {
+		PhaseTimes res;
+		apply([&](auto& g) { res = g.times; });
+		return res;
+	}
+};
+
+// Forwards to a sink and remembers the size of the instance.
+template<class Sink>
+struct SizeRecorder {
+	Sink& sink;
+	long long n, m;
+
+	void begin(long long _n, long long _m, int s, int t, long long max_cap) {
+		n = _n;
+		m = _m;
+		sink.begin(_n, _m, s, t, max_cap);
+	}
+
+	void edge(int from, int to, long long cap) {
+		sink.edge(from, to, cap);
+	}
+};
+
+// Returns the maximum flow of the graph that generate(sink) produces.
+template<template<class> class Solver, class Generate, class Configure>
+long long generateAndSolve(Generate&& generate, Arena& arena, Configure configure) {
+	SolverSink<Solver, Configure> sink(arena, configure);
+	generate(sink);
+	generate(sink);
+	return sink.flow();
+}
+
+template<template<class> class Solver, class Generate>
+long long generateAndSolve(Generate&& generate, Arena& arena) {
+	return generateAndSolve<Solver>(generate, arena, [](auto&) {});
+}
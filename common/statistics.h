@@ -0,0 +1,93 @@
+/*
+ * Robust statistics over repeated measurements.
+ * Description: Timings are skewed by outliers (page faults, preemption),
+ *   so runs are summarized by the median and the median absolute deviation
+ *   and compared with the Mann-Whitney U test, which makes no assumption
+ *   about the distribution. mannWhitneyGreater is exact for small samples
+ *   without ties and uses the normal approximation with tie correction
+ *   otherwise.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+inline double median(std::vector<double> x) {
+	if (x.empty()) return NAN;
+	size_t k = x.size() / 2;
+	std::nth_element(x.begin(), x.begin() + k, x.end());
+	double upper = x[k];
+	if (x.size() % 2 == 1) return upper;
+	return (*std::max_element(x.begin(), x.begin() + k) + upper) / 2;
+}
+
+// Median of |x_i - median(x)|.
+inline double medianAbsoluteDeviation(const std::vector<double>& x) {
+	double m = median(x);
+	std::vector<double> d;
+	for (double v : x) d.push_back(std::fabs(v - m));
+	return median(d);
+}
+
+// One-sided p-value for the hypothesis that values of b tend to be larger
+// than values of a.
+inline double mannWhitneyGreater(const std::vector<double>& a, const std::vector<double>& b) {
+	int na = (int) a.size(), nb = (int) b.size();
+	if (na == 0 || nb == 0) return 1;
+
+	// U counts the pairs with b_j > a_i, ties as one half.
+	double u = 0;
+	for (double x : a) {
+		for (double y : b) u += y > x ? 1 : y == x ? 0.5 : 0;
+	}
+
+	std::vector<double> all(a);
+	all.insert(all.end(), b.begin(), b.end());
+	std::sort(all.begin(), all.end());
+	double ties = 0;
+	for (size_t i = 0, j; i < all.size(); i = j) {
+		for (j = i; j < all.size() && all[j] == all[i]; ++j) {}
+		double t = (double) (j - i);
+		ties += t * t * t - t;
+	}
+
+	if (ties == 0 && na + nb <= 40) {
+		// count[i][u]: orderings of i values of b and j values of a in which
+		// u pairs have the b value larger, for the current j.
+		int max_u = na * nb;
+		std::vector<std::vector<double>> count(nb + 1, std::vector<double>(max_u + 1, 0));
+		for (int i = 0; i <= nb; ++i) count[i][0] = 1;
+		for (int j = 1; j <= na; ++j) {
+			// Adding the largest value: either an a value (no new pairs)
+			// or a b value above all j values of a.
+			for (int i = 1; i <= nb; ++i) {
+				for (int v = max_u; v >= 0; --v) {
+					count[i][v] = count[i][v] + (v >= j ? count[i - 1][v - j] : 0);
+				}
+			}
+		}
+		double total = 0, tail = 0;
+		for (int v = 0; v <= max_u; ++v) {
+			total += count[nb][v];
+			if (v >= u) tail += count[nb][v];
+		}
+		return tail / total;
+	}
+
+	double n = na + nb;
+	double mean = na * (double) nb / 2;
+	double variance = na * (double) nb / 12 * (n + 1 - ties / (n * (n - 1)));
+	if (variance <= 0) return u > mean ? 0 : 1;
+	double z = (u - mean - 0.5) / std::sqrt(variance);
+	return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+// Smallest p-value mannWhitneyGreater returns for samples of these sizes,
+// reached when every value of b is larger than every value of a.
+inline double mannWhitneySmallestP(int na, int nb) {
+	std::vector<double> a, b;
+	for (int i = 0; i < na; ++i) a.push_back(i);
+	for (int i = 0; i < nb; ++i) b.push_back(na + i);
+	return mannWhitneyGreater(a, b);
+}
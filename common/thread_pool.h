@@ -0,0 +1,103 @@
+/*
+ * Fixed pool of worker threads for the parallel solvers.
+ * Description: run(f) calls f(thread) once on every thread of the pool,
+ *   the calling thread being thread 0, and returns when all calls have
+ *   returned, so consecutive runs are separated by a barrier.
+ *   forEach(n, grain, f) calls f(i, thread) for every i in [0, n): the
+ *   threads claim chunks of grain indices from a shared atomic counter,
+ *   so a thread that finishes early takes over the rest of the work.
+ *   Loops of at most grain indices run on the calling thread alone,
+ *   since waking the workers costs more than they would save.
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+private:
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable start, done;
+	std::function<void(int)> job;
+	long long generation;
+	int running;
+	bool stopping;
+
+	void work(int thread) {
+		long long seen = 0;
+		while (true) {
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				start.wait(lock, [&] { return stopping || generation != seen; });
+				if (stopping) return;
+				seen = generation;
+			}
+			job(thread);
+			std::lock_guard<std::mutex> lock(mutex);
+			if (--running == 0) done.notify_one();
+		}
+	}
+
+public:
+	explicit ThreadPool(int threads) : generation(0), running(0), stopping(false) {
+		for (int i = 1; i < threads; ++i) {
+			workers.emplace_back([this, i] { work(i); });
+		}
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		start.notify_all();
+		for (std::thread& worker : workers) worker.join();
+	}
+
+	int size() const {
+		return (int) workers.size() + 1;
+	}
+
+	template<class F>
+	void run(F&& f) {
+		if (workers.empty()) {
+			f(0);
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			job = [&f](int thread) { f(thread); };
+			running = (int) workers.size();
+			generation += 1;
+		}
+		start.notify_all();
+		f(0);
+		std::unique_lock<std::mutex> lock(mutex);
+		done.wait(lock, [&] { return running == 0; });
+	}
+
+	template<class F>
+	void forEach(int n, int grain, F&& f) {
+		if (n <= grain || workers.empty()) {
+			for (int i = 0; i < n; ++i) f(i, 0);
+			return;
+		}
+		std::atomic<int> next(0);
+		run([&](int thread) {
+			int begin;
+			while ((begin = next.fetch_add(grain, std::memory_order_relaxed)) < n) {
+				int end = std::min(begin + grain, n);
+				for (int i = begin; i < end; ++i) f(i, thread);
+			}
+		});
+	}
+};
@@ -12,59 +12,26 @@
  *     ...
  *     from_m to_m cap_m
  *   Vertices are numbered from 1 to n, 1 = source, n = sink.
+ *   Option --format=text|dimacs|binary selects the output format.
+ *   Option --threads=N formats the output on N threads.
  */
 
-#include <cassert>
+#include <cstdlib>
 #include <iostream>
 
-int main () {
-	int max_n, max_m;
-	std::cin >> max_n >> max_m;
-
-	assert(max_n >= 14);
-	assert(max_m >= 19);
-
-	int n = 2;
-
-	while (4 * (n + 1) + 6 <= max_n && 6 * (n + 1) + 7 <= max_m) {
-		++n;
-	}
-
-	std::cout << 4 * n + 6 << ' ' << 6 * n + 7 << '\n';
-
-	/* first terrible graph */
-
-	for (int i = 0; i < n ; ++i) {
-		std::cout << i + 2 << ' ' << i + 3 << ' ' << n - i + 1 << '\n';
-		std::cout << i + 2 << ' ' << n + 3 << ' ' << 1 << '\n';
-	}
+#include "../common/graph_sink.h"
+#include "../common/options.h"
+#include "ak.h"
 
-	std::cout << n + 2 << ' ' << 2 * n + 3 << ' ' << 1 << '\n';
-	std::cout << n + 2 << ' ' << n + 3 << ' ' << 1 << '\n';
+int main(int argc, char* argv[]) {
+	Format format = parseFormat(getOption(argc, argv, "format", "text"));
+	int threads = std::atoi(getOption(argc, argv, "threads", "1"));
 
-	for (int i = n + 3; i <= 2 * n + 2; ++i) {
-		std::cout << i << ' ' << i + 1 << ' ' << n + 1 << '\n';
-	}
-
-	/* second horrible graph */
-
-	int d = 2 * n + 4;
-
-	for (int i = d; i <= 2 * n + d; ++i) {
-		std::cout << i << ' ' << i + 1 << ' ' << n << '\n';
-	}
-
-	for (int i = 0; i < n; ++i) {
-		std::cout << i + d << ' ' << 2 * n + 1 - i + d << ' ' << 1 << '\n';
-	}
-
-	/* edges from source and to sink */
+	int max_n, max_m;
+	std::cin >> max_n >> max_m;
 
-	std::cout << "1 2 1000000000" << '\n';
-	std::cout << "1 " << d << " 1000000000" << '\n';
-	std::cout << d - 1 << ' ' << 4 * n + 6 << " 1000000000" << '\n';
-	std::cout << 4 * n + 5 << ' ' << 4 * n + 6 << " 1000000000" << '\n';
+	FileSink sink(format, threads);
+	ak::generate(max_n, max_m, 1'000'000'000, 0, sink);
 
 	return 0;
 }
-
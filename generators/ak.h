@@ -0,0 +1,63 @@
+/*
+ * AK generator of hard maxflow problems (Cherkassky and Goldberg), library form.
+ * Description: generate(max_n, max_m, max_cap, seed, sink) passes the
+ *   graph that ak.cpp prints to a sink (see common/graph_sink.h).
+ *   The graph does not depend on the seed.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+namespace ak {
+
+template<class Sink>
+void generate(int max_n, int max_m, int max_cap, uint64_t /*seed*/, Sink& sink) {
+	assert(max_n >= 14);
+	assert(max_m >= 19);
+	assert(max_cap >= 1);
+
+	int n = std::max(2, std::min((max_n - 6) / 4, (max_m - 7) / 6));
+
+	// No cut is larger than n + 2, so the edges from the source and to
+	// the sink need no more capacity than that.
+	int inf = std::min(max_cap, n + 2);
+
+	sink.begin(4 * n + 6, 6 * n + 7, 1, 4 * n + 6, std::max(n + 1, inf));
+
+	/* first terrible graph */
+
+	for (int i = 0; i < n ; ++i) {
+		sink.edge(i + 2, i + 3, n - i + 1);
+		sink.edge(i + 2, n + 3, 1);
+	}
+
+	sink.edge(n + 2, 2 * n + 3, 1);
+	sink.edge(n + 2, n + 3, 1);
+
+	for (int i = n + 3; i <= 2 * n + 2; ++i) {
+		sink.edge(i, i + 1, n + 1);
+	}
+
+	/* second horrible graph */
+
+	int d = 2 * n + 4;
+
+	for (int i = d; i <= 2 * n + d; ++i) {
+		sink.edge(i, i + 1, n);
+	}
+
+	for (int i = 0; i < n; ++i) {
+		sink.edge(i + d, 2 * n + 1 - i + d, 1);
+	}
+
+	/* edges from source and to sink */
+
+	sink.edge(1, 2, inf);
+	sink.edge(1, d, inf);
+	sink.edge(d - 1, 4 * n + 6, inf);
+	sink.edge(4 * n + 5, 4 * n + 6, inf);
+}
+
+} // namespace ak
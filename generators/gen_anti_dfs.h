@@ -0,0 +1,62 @@
+/*
+ * Anti-DFS-Augmenting-Paths Graph Generator, library form.
+ * Description: generate(max_n, max_m, max_cap, seed, sink) passes the
+ *   graph that gen_anti_dfs.cpp prints to a sink (see common/graph_sink.h).
+ *   The graph does not depend on the seed.
+ */
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+namespace gen_anti_dfs {
+
+template<class Sink>
+void generate(int max_n, int max_m, int max_cap, uint64_t /*seed*/, Sink& sink) {
+	assert(max_n >= 2);
+	assert(max_m >= 1);
+	assert(max_cap >= 1);
+
+	if (max_n < 4 || max_m < 5) {
+		sink.begin(2, 1, 1, 2, 1);
+		sink.edge(1, 2, 1);
+		return;
+	}
+
+	// Every iteration adds 2 vertices and 4 edges, except that the last
+	// one reuses the source, so n and m follow from the iteration count.
+	int iterations = 1;
+	while (true) {
+		long long n = 3 + 2LL * (iterations - 1);
+		long long m = 1 + 4LL * (iterations - 1);
+		if (n + 3 > max_n) break;
+		if (m + 8 > max_m) break;
+		if (2LL << (iterations - 1) > max_cap) break;
+		iterations += 1;
+	}
+
+	int n = 2 + 2 * iterations;
+	int m = 1 + 4 * iterations;
+
+	sink.begin(n, m, 1, n, 1 << (iterations - 1));
+
+	sink.edge(2, 3, 1);
+
+	for (int i = 0; i < iterations; ++i) {
+		bool last_iteration = (i == iterations - 1);
+
+		int cur_s = 2 + 2 * i;
+		int cur_t = 3 + 2 * i;
+		int cur_cap = 1 << i;
+
+		int next_s = (last_iteration ? 1 : cur_s + 2);
+		int next_t = (last_iteration ? cur_t + 1 : cur_t + 2);
+
+		sink.edge(next_s, cur_s, cur_cap);
+		sink.edge(next_s, cur_t, cur_cap);
+		sink.edge(cur_s, next_t, cur_cap);
+		sink.edge(cur_t, next_t, cur_cap);
+	}
+}
+
+} // namespace gen_anti_dfs
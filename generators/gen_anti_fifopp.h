@@ -0,0 +1,80 @@
+/*
+ * Anti-FIFO-Preflow-Push Graph Generator, library form.
+ * Description: generate(max_n, max_m, max_cap, seed, sink) passes the
+ *   graph that gen_anti_fifopp.cpp prints to a sink (see common/graph_sink.h).
+ *   The graph does not depend on the seed.
+ */
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#include "../common/search.h"
+
+namespace gen_anti_fifopp {
+
+const int STEP = 4;
+
+template<class Sink>
+void generate(int max_n, int max_m, int max_cap, uint64_t /*seed*/, Sink& sink) {
+	auto num_vertices = [&](int k) {
+		return 2LL * k + (2LL * k - 1) * STEP + 4;
+	};
+
+	auto num_edges = [&](int k) {
+		return 1 + 3LL * k + 2LL * k + (2LL * k - 1) * STEP;
+	};
+
+	// The flow is at most 2 k^2, so no edge needs more capacity.
+	auto max_capacity = [&](int k) {
+		return 2LL * k * k;
+	};
+
+	assert(max_n >= num_vertices(1));
+	assert(max_m >= num_edges(1));
+	assert(max_cap >= 2);
+
+	auto ok = [&](int k) {
+		if (num_vertices(k) > max_n) return false;
+		if (num_edges(k) > max_m) return false;
+		if (max_capacity(k) > max_cap) return false;
+		return true;
+	};
+
+	int k = lastTrue(2, max_n, ok);
+
+	int n = num_vertices(k);
+	int inf = max_capacity(k);
+
+	// Vertex ids in the order the vertices are created.
+	int s = 1;
+	auto a = [&](int i) { return 2 + 2 * i; };
+	auto b = [&](int i) { return 3 + 2 * i; };
+	int p = 2 * k + 2;
+	int q = 2 * k + 3;
+	auto line = [&](int i) { return n - i; };
+
+	sink.begin(n, num_edges(k), 1, n, inf);
+
+	for (int i = 0; i < k; ++i) {
+		sink.edge(a(i), b(i), (i == k - 1 ? inf : 1));
+	}
+
+	sink.edge(s, p, inf);
+
+	for (int i = 0; i < k; ++i) {
+		sink.edge(p, a(i), inf);
+		sink.edge(b(i), q, inf);
+	}
+
+	for (int i = (2 * k - 1) * STEP; i >= 1; --i) {
+		sink.edge(line(i), line(i - 1), inf);
+	}
+
+	for (int i = 0; i < k; ++i) {
+		sink.edge(q, line(2 * i * STEP), k);
+		sink.edge(p, line((2 * i + 1) * STEP), k);
+	}
+}
+
+} // namespace gen_anti_fifopp
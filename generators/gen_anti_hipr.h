@@ -0,0 +1,397 @@
+/*
+ * Anti hi_pr.c Graph Generator, library form.
+ * Description: generate(max_n, max_m, max_cap, seed, sink) passes the
+ *   graph that gen_anti_hipr.cpp prints to a sink (see common/graph_sink.h).
+ *   The graph depends only on max_m and max_cap.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "../common/external_memory.h"
+#include "../common/search.h"
+
+namespace gen_anti_hipr {
+
+struct Edge {
+	int from, to, cap;
+};
+
+inline long long num_edges(int K, int W, int L) {
+	return 2LL * (18LL * L + 2LL * W * (2LL * K + 5) + 1LL * W * W + 5LL);
+}
+
+inline long long max_capacity(int /*K*/, int W, int L) {
+	return 2LL * L * W * W + 4LL * L + 1LL;
+}
+
+inline long long estimated_work(int K, int W, int L) {
+	return 2LL * L * W * W * K;
+}
+
+// Largest L with ok(K, W, L), or 0 if there is none.
+inline long long max_length(int max_m, int max_cap, long long K, long long W) {
+	long long by_m = (max_m / 2 - 5LL - 2LL * W * (2LL * K + 5) - W * W) / 18;
+	long long by_cap = (max_cap - 1LL) / (2LL * W * W + 4);
+	return std::max(0LL, std::min(by_m, by_cap));
+}
+
+// max_length without the rounding. It is linear in K while one constraint
+// is tight, so K * length_bound is concave in K.
+inline long double length_bound(int max_m, int max_cap, long long K, long long W) {
+	long double by_m = (max_m / 2 - 5.0L - 2.0L * W * (2.0L * K + 5) - 1.0L * W * W) / 18;
+	long double by_cap = (max_cap - 1.0L) / (2.0L * W * W + 4);
+	return std::min(by_m, by_cap);
+}
+
+// Maximizes estimated_work over all (K, W) with the largest feasible L.
+// Among equal work the smallest K wins, then the smallest W.
+inline std::array<int, 3> best_parameters(int max_m, int max_cap) {
+	int best_K = 1;
+	int best_W = 1;
+	int best_L = 1;
+	long long best_work = estimated_work(1, 1, 1);
+
+	auto consider = [&](long long K, long long W) {
+		long long L = max_length(max_m, max_cap, K, W);
+		if (L == 0) return;
+		long long work = estimated_work(K, W, L);
+		if (work > best_work || (work == best_work && (K < best_K || (K == best_K && W < best_W)))) {
+			best_K = K;
+			best_W = W;
+			best_L = L;
+			best_work = work;
+		}
+	};
+
+	// Same search as in gen_anti_hlpp.h: for a fixed W only the K where the
+	// concave bound 2 W^2 K length_bound(K) reaches the best work are tried.
+	for (long long W = 1; max_length(max_m, max_cap, 1, W) > 0; ++W) {
+		// Largest K with max_length >= 1; K = 1 is feasible.
+		long long max_K = (max_m / 2 - 23LL - 10LL * W - W * W) / (4LL * W);
+		// The work is below K * max_cap and max_K only shrinks with W.
+		if (1.0L * max_K * max_cap < best_work) break;
+		if (2.0L * W * W * max_K * ((max_cap - 1.0L) / (2.0L * W * W + 4)) + 1 < best_work) continue;
+
+		auto bound = [&](long long K) {
+			return 2.0L * W * W * K * length_bound(max_m, max_cap, K, W) * (1 + 1e-12L) + 1;
+		};
+		long long top = firstTrue(1, max_K, [&](long long K) {
+			return K == max_K || bound(K) >= bound(K + 1);
+		});
+		consider(top, W);
+		if (bound(top) < best_work) continue;
+		long long lo = firstTrue(1, top, [&](long long K) { return bound(K) >= best_work; });
+		long long hi = lastTrue(top, max_K, [&](long long K) { return bound(K) >= best_work; });
+		for (long long K = lo; K <= hi; ++K) consider(K, W);
+	}
+
+	return std::array<int, 3>{best_K, best_W, best_L};
+}
+
+// Calls edge(from, to, cap) for every edge of the graph, before it is
+// reordered for hi_pr.c. Returns the number of vertices.
+template<class F>
+int baseGraph(int K, int W, int L, int inf, F&& edge) {
+	// Vertex ids in the order the vertices are created.
+	int s2 = 1;
+	int s = 2;
+	int a1 = 3;
+	auto v1 = [&](int i, int j) { return a1 + 1 + i * W + j; };
+	int b1 = v1(K + 3, 0);
+	int a2 = b1 + 1;
+	auto v2 = [&](int i, int j) { return a2 + 1 + i * W + j; };
+	int b2 = v2(K + 3, 0);
+	int p1 = b2 + 1;
+	auto v3 = [&](int i, int j) { return p1 + 1 + i * W + j; };
+	int q1 = v3(K, 0);
+	int p2 = q1 + 1;
+	auto v4 = [&](int i, int j) { return p2 + 1 + i * W + j; };
+	int q2 = v4(K, 0);
+	auto c = [&](int i) { return q2 + 1 + i; };
+	auto line = [&](int i) { return q2 + 8 * L + 1 - i; };
+	int t = q2 + 8 * L + 2;
+
+	edge(s2, s, inf);
+	edge(s, t, 1);
+	edge(line(0), t, inf);
+
+	for (int i = 0; i < 2 * L; ++i) {
+		edge(s, c(i), W * W + 2);
+		edge(c(i), line(0), 1);
+		edge(c(i), (i % 2 == 0 ? a2 : a1), W * W);
+		edge(c(i), (i % 2 == 0 ? b2 : b1), 1);
+	}
+
+	for (int j = 0; j < W; ++j) {
+		edge(a1, v1(0, j), W);
+		edge(a2, v2(0, j), W);
+	}
+
+	for (int i = 0; i + 1 < K + 3; ++i) {
+		for (int j = 0; j < W; ++j) {
+			edge(v1(i, j), v1(i + 1, j), W);
+			edge(v2(i, j), v2(i + 1, j), W);
+		}
+	}
+
+	for (int j = 0; j < W; ++j) {
+		edge(v1(K + 2, j), b1, W);
+		edge(v2(K + 2, j), b2, W);
+	}
+
+	for (int i = 0; i < L; ++i) {
+		edge(b1, line(6 * i), 1);
+		edge(b2, line(6 * i + 3), 1);
+	}
+
+	edge(a1, p1, inf);
+	edge(a2, p2, inf);
+
+	for (int j = 0; j < W; ++j) {
+		edge(p1, v3(0, j), inf);
+		edge(p2, v4(0, j), inf);
+	}
+
+	for (int i = 0; i + 1 < K; ++i) {
+		for (int j = 0; j < W; ++j) {
+			edge(v3(i, j), v3(i + 1, j), inf);
+			edge(v4(i, j), v4(i + 1, j), inf);
+		}
+	}
+
+	for (int j = 0; j < W; ++j) {
+		edge(v3(K - 1, j), q1, inf);
+		edge(v4(K - 1, j), q2, inf);
+	}
+
+	for (int i = 0; i < W; ++i) {
+		for (int j = 0; j < W; ++j) {
+			edge(v3(0, i), v4(0, j), 1);
+		}
+	}
+
+	for (int i = 0; i < L; ++i) {
+		edge(q1, line(6 + 6 * i), W * W);
+		edge(q2, line(3 + 6 * i), W * W);
+	}
+
+	for (int i = 6 * L; i >= 1; --i) {
+		edge(line(i), line(i - 1), inf);
+	}
+
+	return t;
+}
+
+struct Incidence {
+	int vertex, id, other;
+};
+
+struct Assignment {
+	int id, dummy, seq;
+};
+
+struct Placement {
+	int dummy, seq;
+	Edge edge;
+};
+
+// Produces the same graph as the reordering in generate, but everything
+// of size O(m) lives in temporary files: the sorts below keep about
+// memory bytes in RAM, and the kernel pages the two arrays out as needed.
+template<class Sink>
+void reorderExternal(int K, int W, int L, int inf, size_t memory, Sink& sink) {
+	auto by_vertex = [](const Incidence& a, const Incidence& b) {
+		return std::tie(a.vertex, a.id) < std::tie(b.vertex, b.id);
+	};
+	auto by_id = [](const Assignment& a, const Assignment& b) {
+		return a.id < b.id;
+	};
+	auto by_dummy = [](const Placement& a, const Placement& b) {
+		return std::tie(a.dummy, a.seq) < std::tie(b.dummy, b.seq);
+	};
+
+	// Edge ids are positions in sorted order. The sorted edges are kept
+	// in a file, to be read back in id order at the end.
+	ExternalSorter<Incidence, decltype(by_vertex)> order(memory / 2, by_vertex);
+	FILE* sorted = tempFile();
+	int n, m = 0;
+	{
+		auto by_endpoints = [](const Edge& e1, const Edge& e2) {
+			return std::tie(e1.from, e1.to, e1.cap) < std::tie(e2.from, e2.to, e2.cap);
+		};
+		ExternalSorter<Edge, decltype(by_endpoints)> edges(memory / 2, by_endpoints);
+		n = baseGraph(K, W, L, inf, [&](int from, int to, int cap) {
+			edges.push({from, to, cap});
+		});
+		edges.forEach([&](const Edge& e) {
+			order.push({e.from, m, e.to});
+			order.push({e.to, m, e.from});
+			std::fwrite(&e, sizeof(e), 1, sorted);
+			m += 1;
+		});
+	}
+
+	// An edge is seen first at its smaller endpoint, so the number of
+	// dummy vertices follows without knowing which dummy holds which edge.
+	int dummies = 0;
+	int open_size = 0;
+	order.forEach([&](const Incidence& x) {
+		if (x.vertex > x.other) open_size += 1;
+		else if (open_size > 0) open_size -= 1;
+		else dummies += 1;
+	});
+
+	sink.begin(n + dummies, 2LL * m, 1, n, inf);
+
+	ExternalSorter<Assignment, decltype(by_id)> assigned(memory / 2, by_id);
+	{
+		FileArray<int> have(m);
+		FileArray<int> open(dummies);
+		int next_dummy = n + 1;
+		int seq = 0;
+		int prev = 0;
+		bool second = false;
+		open_size = 0;
+		order.forEach([&](const Incidence& x) {
+			int u = -1;
+			if (x.vertex < x.other) {
+				u = (open_size > 0 ? open[--open_size] : next_dummy++);
+				have[x.id] = u;
+				assigned.push({x.id, u, seq++});
+			}
+			else {
+				u = have[x.id];
+				open[open_size++] = u;
+			}
+			if (second) sink.edge(prev, u, 1);
+			prev = u;
+			second = !second;
+		});
+	}
+
+	ExternalSorter<Placement, decltype(by_dummy)> placed(memory / 2, by_dummy);
+	std::rewind(sorted);
+	assigned.forEach([&](const Assignment& a) {
+		Edge e;
+		if (std::fread(&e, sizeof(e), 1, sorted) != 1) {
+			throw std::runtime_error("cannot read temporary file");
+		}
+		placed.push({a.dummy, a.seq, e});
+	});
+	std::fclose(sorted);
+
+	placed.forEach([&](const Placement& p) {
+		sink.edge(p.edge.from, p.edge.to, p.edge.cap);
+	});
+}
+
+// max_n and seed are ignored. With memory > 0, the graph is reordered in
+// temporary files using about that many bytes of RAM.
+template<class Sink>
+void generate(int /*max_n*/, int max_m, int max_cap, uint64_t /*seed*/, Sink& sink, size_t memory = 0) {
+	assert(max_m >= 74);
+	assert(max_cap >= 4);
+
+	auto [K, W, L] = best_parameters(max_m, max_cap);
+	int inf = max_capacity(K, W, L);
+
+	if (memory > 0) {
+		reorderExternal(K, W, L, inf, memory, sink);
+		return;
+	}
+
+	std::vector<Edge> edges;
+	int n = baseGraph(K, W, L, inf, [&](int from, int to, int cap) {
+		edges.push_back({from, to, cap});
+	});
+	int t = n;
+
+	std::sort(edges.begin(), edges.end(), [&](const Edge& e1, const Edge& e2) {
+		if (e1.from < e2.from) return true;
+		if (e1.from > e2.from) return false;
+		return e1.to < e2.to;
+	});
+
+	// Rest is just making sure the edge order by hi_pr.c will be correct
+	std::vector<std::vector<int>> ve(n + 1);
+
+	for (int i = 0; i < (int) edges.size(); ++i) {
+		int u = edges[i].from;
+		int v = edges[i].to;
+		ve[u].push_back(i);
+		ve[v].push_back(i);
+	}
+
+	std::vector<int> order;
+
+	for (int i = 1; i <= n; ++i) {
+		for (int id : ve[i]) order.push_back(id);
+	}
+	
+	assert(order.size() % 2 == 0);
+
+	std::vector<int> have(edges.size(), -1);
+	std::vector<int> open;
+
+	std::vector<Edge> final_edges;
+
+	for (int i = 0; i < (int) order.size(); ++i) {
+		int u = -1;
+		if (have[order[i]] == -1) {
+			if (open.empty()) {
+				open.push_back((int) ve.size());
+				ve.push_back(std::vector<int>());
+			}
+			u = open.back();
+			open.pop_back();
+			have[order[i]] = u;
+			ve[u].push_back(order[i]);
+		}
+		else {
+			u = have[order[i]];
+			open.push_back(u);
+		}
+		i += 1;
+		int v = -1;
+		if (have[order[i]] == -1) {
+			if (open.empty()) {
+				open.push_back((int) ve.size());
+				ve.push_back(std::vector<int>());
+			}
+			v = open.back();
+			open.pop_back();
+			have[order[i]] = v;
+			ve[v].push_back(order[i]);
+		}
+		else {
+			v = have[order[i]];
+			open.push_back(v);
+		}
+		final_edges.push_back({u, v, 1});
+	}
+
+	for (int i = n + 1; i < (int) ve.size(); ++i) {
+		for (int id : ve[i]) {
+			final_edges.push_back(edges[id]);
+		}
+	}
+
+	assert((int) ve.size() <= max_m);
+	assert((int) final_edges.size() <= max_m);
+
+	sink.begin(ve.size() - 1, final_edges.size(), 1, t, inf);
+
+	for (const Edge& e : final_edges) {
+		sink.edge(e.from, e.to, e.cap);
+	}
+}
+
+} // namespace gen_anti_hipr
@@ -0,0 +1,192 @@
+/*
+ * Anti-Highest-Label-Preflow-Push Graph Generator, library form.
+ * Description: generate(max_n, max_m, max_cap, seed, sink) passes the
+ *   graph that gen_anti_hlpp.cpp prints to a sink (see common/graph_sink.h).
+ *   The graph does not depend on the seed.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+#include "../common/search.h"
+
+namespace gen_anti_hlpp {
+
+inline long long num_vertices(int K, int W, int L) {
+	return 10LL + 8LL * L + 2LL * W * (2LL * K + 3);
+}
+
+inline long long num_edges(int K, int W, int L) {
+	return 18LL * L + 2LL * W * (2LL * K + 5) + 1LL * W * W + 2LL;
+}
+
+inline long long max_capacity(int /*K*/, int W, int L) {
+	return 2LL * L * W * W + 4LL * L;
+}
+
+inline long long estimated_work(int K, int W, int L) {
+	return 2LL * L * W * W * K;
+}
+
+// Largest L with ok(K, W, L), or 0 if there is none.
+inline long long max_length(int max_n, int max_m, int max_cap, long long K, long long W) {
+	long long by_n = (max_n - 10LL - 2LL * W * (2LL * K + 3)) / 8;
+	long long by_m = (max_m - 2LL - 2LL * W * (2LL * K + 5) - W * W) / 18;
+	long long by_cap = max_cap / (2LL * W * W + 4);
+	return std::max(0LL, std::min({by_n, by_m, by_cap}));
+}
+
+// max_length without the rounding. It is linear in K while one constraint
+// is tight, so K * length_bound is concave in K.
+inline long double length_bound(int max_n, int max_m, int max_cap, long long K, long long W) {
+	long double by_n = (max_n - 10.0L - 2.0L * W * (2.0L * K + 3)) / 8;
+	long double by_m = (max_m - 2.0L - 2.0L * W * (2.0L * K + 5) - 1.0L * W * W) / 18;
+	long double by_cap = max_cap / (2.0L * W * W + 4);
+	return std::min({by_n, by_m, by_cap});
+}
+
+// Maximizes estimated_work over all (K, W) with the largest feasible L.
+// Among equal work the smallest K wins, then the smallest W.
+inline std::array<int, 3> best_parameters(int max_n, int max_m, int max_cap) {
+	int best_K = 1;
+	int best_W = 1;
+	int best_L = 1;
+	long long best_work = estimated_work(1, 1, 1);
+
+	auto consider = [&](long long K, long long W) {
+		long long L = max_length(max_n, max_m, max_cap, K, W);
+		if (L == 0) return;
+		long long work = estimated_work(K, W, L);
+		if (work > best_work || (work == best_work && (K < best_K || (K == best_K && W < best_W)))) {
+			best_K = K;
+			best_W = W;
+			best_L = L;
+			best_work = work;
+		}
+	};
+
+	// For a fixed W the work is at most 2 W^2 K length_bound(K), which is
+	// concave in K. Only the K where that bound still reaches the best work
+	// found so far are evaluated. The slack covers rounding.
+	for (long long W = 1; max_length(max_n, max_m, max_cap, 1, W) > 0; ++W) {
+		// Largest K with max_length >= 1; K = 1 is feasible.
+		long long max_K = std::min((max_n - 18LL - 6LL * W) / (4LL * W), (max_m - 20LL - 10LL * W - W * W) / (4LL * W));
+		// The work is below K * max_cap and max_K only shrinks with W.
+		if (1.0L * max_K * max_cap < best_work) break;
+		if (2.0L * W * W * max_K * (max_cap / (2.0L * W * W + 4)) + 1 < best_work) continue;
+
+		auto bound = [&](long long K) {
+			return 2.0L * W * W * K * length_bound(max_n, max_m, max_cap, K, W) * (1 + 1e-12L) + 1;
+		};
+		long long top = firstTrue(1, max_K, [&](long long K) {
+			return K == max_K || bound(K) >= bound(K + 1);
+		});
+		consider(top, W);
+		if (bound(top) < best_work) continue;
+		long long lo = firstTrue(1, top, [&](long long K) { return bound(K) >= best_work; });
+		long long hi = lastTrue(top, max_K, [&](long long K) { return bound(K) >= best_work; });
+		for (long long K = lo; K <= hi; ++K) consider(K, W);
+	}
+
+	return std::array<int, 3>{best_K, best_W, best_L};
+}
+
+template<class Sink>
+void generate(int max_n, int max_m, int max_cap, uint64_t /*seed*/, Sink& sink) {
+	assert(max_n >= 30);
+	assert(max_m >= 37);
+	assert(max_cap >= 4);
+
+	auto [K, W, L] = best_parameters(max_n, max_m, max_cap);
+	int inf = max_capacity(K, W, L);
+
+	int n = num_vertices(K, W, L);
+
+	// Vertex ids in the order the vertices are created.
+	int s = 1;
+	int a1 = 2;
+	auto v1 = [&](int i, int j) { return a1 + 1 + i * W + j; };
+	int b1 = v1(K + 3, 0);
+	int a2 = b1 + 1;
+	auto v2 = [&](int i, int j) { return a2 + 1 + i * W + j; };
+	int b2 = v2(K + 3, 0);
+	int p1 = b2 + 1;
+	auto v3 = [&](int i, int j) { return p1 + 1 + i * W + j; };
+	int q1 = v3(K, 0);
+	int p2 = q1 + 1;
+	auto v4 = [&](int i, int j) { return p2 + 1 + i * W + j; };
+	int q2 = v4(K, 0);
+	auto c = [&](int i) { return q2 + 1 + i; };
+	auto line = [&](int i) { return n - i; };
+
+	sink.begin(n, num_edges(K, W, L), 1, n, inf);
+
+	for (int i = 0; i < 2 * L; ++i) {
+		sink.edge(s, c(i), inf);
+		sink.edge(c(i), line(0), 1);
+		sink.edge(c(i), (i % 2 == 0 ? a2 : a1), W * W);
+		sink.edge(c(i), (i % 2 == 0 ? b2 : b1), 1);
+	}
+
+	for (int j = 0; j < W; ++j) {
+		sink.edge(a1, v1(0, j), W);
+		sink.edge(a2, v2(0, j), W);
+	}
+
+	for (int i = 0; i + 1 < K + 3; ++i) {
+		for (int j = 0; j < W; ++j) {
+			sink.edge(v1(i, j), v1(i + 1, j), W);
+			sink.edge(v2(i, j), v2(i + 1, j), W);
+		}
+	}
+
+	for (int j = 0; j < W; ++j) {
+		sink.edge(v1(K + 2, j), b1, W);
+		sink.edge(v2(K + 2, j), b2, W);
+	}
+
+	for (int i = 0; i < L; ++i) {
+		sink.edge(b1, line(6 * i), 1);
+		sink.edge(b2, line(6 * i + 3), 1);
+	}
+
+	sink.edge(a1, p1, inf);
+	sink.edge(a2, p2, inf);
+
+	for (int j = 0; j < W; ++j) {
+		sink.edge(p1, v3(0, j), inf);
+		sink.edge(p2, v4(0, j), inf);
+	}
+
+	for (int i = 0; i + 1 < K; ++i) {
+		for (int j = 0; j < W; ++j) {
+			sink.edge(v3(i, j), v3(i + 1, j), inf);
+			sink.edge(v4(i, j), v4(i + 1, j), inf);
+		}
+	}
+
+	for (int j = 0; j < W; ++j) {
+		sink.edge(v3(K - 1, j), q1, inf);
+		sink.edge(v4(K - 1, j), q2, inf);
+	}
+
+	for (int i = 0; i < W; ++i) {
+		for (int j = 0; j < W; ++j) {
+			sink.edge(v3(0, i), v4(0, j), 1);
+		}
+	}
+
+	for (int i = 0; i < L; ++i) {
+		sink.edge(q1, line(6 + 6 * i), W * W);
+		sink.edge(q2, line(3 + 6 * i), W * W);
+	}
+
+	for (int i = 6 * L; i >= 1; --i) {
+		sink.edge(line(i), line(i - 1), inf);
+	}
+}
+
+} // namespace gen_anti_hlpp
@@ -0,0 +1,84 @@
+/*
+ * Anti-Most-Improving-Augmenting-Paths Graph Generator, library form.
+ * Description: generate(max_n, max_m, max_cap, seed, sink) passes the
+ *   graph that gen_anti_most_improving.cpp prints to a sink (see common/graph_sink.h).
+ *   The graph does not depend on the seed.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace gen_anti_most_improving {
+
+template<class Sink>
+void generate(int max_n, int max_m, int max_cap, uint64_t /*seed*/, Sink& sink) {
+	assert(max_n >= 10);
+	assert(max_m >= 17);
+	assert(max_cap >= 3);
+
+	std::vector<int> fib(46, 1);
+
+	for (int i = 2; i <= 45; ++i) {
+		fib[i] = fib[i - 1] + fib[i - 2];
+	}
+
+	int k = 1;
+	while (k + 1 <= 15 && fib[3 * (k + 1)] <= max_cap) k += 1;
+
+	std::vector<int> w(5);
+
+	for (int i = 0; i < 3; ++i) {
+		w[i] = 0;
+		for (int j = 0; j < k; ++j) {
+			w[i] += fib[3 * j + i];
+		}
+	}
+
+	w[3] = fib[3 * k - 1];
+	w[4] = fib[3 * k];
+
+	const std::vector<std::vector<std::pair<int, int>>> EDGES = {
+		{{0, 5}, {5, 6}, {1, 2}, {7, 8}, {3, 9}},
+		{{0, 6}, {1, 7}, {2, 3}, {8, 9}},
+		{{0, 1}, {6, 7}, {2, 8}, {3, 4}, {4, 9}},
+		{{1, 6}, {8, 3}},
+		{{7, 2}},
+	};
+
+	int n = 0;
+
+	int l = std::min((max_n - 2) / 8, max_m / 17);
+
+	assert(8 * l + 2 <= max_n);
+	assert(17 * l <= max_m);
+
+	sink.begin(8 * l + 2, 17 * l, 1, 8 * l + 2, *std::max_element(w.begin(), w.end()));
+
+	int s = ++n;
+	int t = 8 * l + 2;
+
+	auto antiMostImproving = [&]() {
+		std::vector<int> v(10);
+		v[0] = s;
+		v[9] = t;
+		for (int i = 1; i <= 8; ++i) {
+			v[i] = ++n;
+		}
+		for (int i = 0; i < 5; ++i) {
+			for (auto [a, b] : EDGES[i]) {
+				sink.edge(v[a], v[b], w[i]);
+			}
+		}
+	};
+
+	for (int i = 0; i < l; ++i) {
+		antiMostImproving();
+	}
+
+	assert(n + 1 == 8 * l + 2);
+}
+
+} // namespace gen_anti_most_improving
@@ -0,0 +1,144 @@
+/*
+ * Anti-Scaling-DFS Graph Generator, library form.
+ * Description: generate(max_n, max_m, max_cap, seed, sink) passes the
+ *   graph that gen_anti_scaling_dfs.cpp prints to a sink (see common/graph_sink.h).
+ *   The graph does not depend on the seed.
+ */
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "../common/search.h"
+
+namespace gen_anti_scaling_dfs {
+
+inline int log2_ceil(long long x) {
+	int ans = 0;
+	while ((1LL << ans) < x) ans += 1;
+	return ans;
+}
+
+inline long long num_vertices(int p, int w) {
+	return 3LL + 2LL * w + 1LL * p * (log2_ceil(1LL * w * w) * 2LL + 2LL);
+}
+
+inline long long num_edges(int p, int w) {
+	return 2LL * w + 1LL * w * w + 2LL * p + 1LL * p * (log2_ceil(1LL * w * w) * 4LL + 1LL);
+}
+
+inline long long max_capacity(int p, int w) {
+	return std::max(1LL * w * ((1LL << p) - 1LL), 1LL * w * w * (1LL << (p - 1)));
+}
+
+inline long long num_augmenting_paths(int p, int w) {
+	return 1LL * p * w * w;
+}
+
+inline std::pair<int, int> best_parameters(int max_n, int max_m, int max_cap) {
+	auto ok = [&](int p, int w) {
+		if (num_vertices(p, w) > max_n) return false;
+		if (num_edges(p, w) > max_m) return false;
+		if (max_capacity(p, w) > max_cap) return false;
+		return true;
+	};
+
+	int best_p = 1;
+	int best_w = 1;
+
+	// Everything grows with w, so for each p only the largest feasible w
+	// can improve the best number of paths.
+	for (int p = 1; p <= 29; ++p) {
+		int w = lastTrue(1, max_m, [&](long long x) {
+			return x * x <= max_m && max_capacity(p, x) <= max_cap && ok(p, x);
+		});
+		if (w == 0) continue;
+		if (num_augmenting_paths(p, w) > num_augmenting_paths(best_p, best_w)) {
+			best_p = p;
+			best_w = w;
+		}
+	}
+
+	return std::make_pair(best_p, best_w);
+}
+
+template<class Sink>
+std::pair<int, int> anti_dfs_graph(int need_paths, int unit_cap, int& n, Sink& sink) {
+	int cur_s = ++n;
+	int cur_t = ++n;
+	int cur_cap = unit_cap;
+	sink.edge(cur_s, cur_t, cur_cap);
+
+	int have_paths = 1;
+
+	while (have_paths < need_paths) {
+		int next_s = ++n;
+		int next_t = ++n;
+
+		sink.edge(next_s, cur_s, cur_cap);
+		sink.edge(next_s, cur_t, cur_cap);
+		sink.edge(cur_s, next_t, cur_cap);
+		sink.edge(cur_t, next_t, cur_cap);
+
+		cur_s = next_s;
+		cur_t = next_t;
+		cur_cap *= 2;
+		have_paths *= 2;
+	}
+
+	return std::make_pair(cur_s, cur_t);
+}
+
+template<class Sink>
+void generate(int max_n, int max_m, int max_cap, uint64_t /*seed*/, Sink& sink) {
+	assert(max_n >= 7);
+	assert(max_m >= 6);
+	assert(max_cap >= 1);
+
+	auto [p, w] = best_parameters(max_n, max_m, max_cap);
+
+	// No edge carries more than max_capacity(p, w) units of flow, so the
+	// edges from the source and to the sink need no more capacity.
+	int inf = max_capacity(p, w);
+
+	int n = 0;
+
+	sink.begin(num_vertices(p, w), num_edges(p, w), 1, num_vertices(p, w), inf);
+
+	int s = ++n;
+	int x = ++n;
+
+	auto a = [&](int i) { return 3 + 2 * i; };
+	auto b = [&](int i) { return 4 + 2 * i; };
+	n += 2 * w;
+
+	for (int i = 0; i < w; ++i) {
+		sink.edge(s, a(i), inf);
+		sink.edge(b(i), x, inf);
+	}
+
+	for (int i = 0; i < w; ++i) {
+		for (int j = 0; j < w; ++j) {
+			sink.edge(a(i), b(j), (1 << p) - 1);
+		}
+	}
+
+	std::vector<int> vt;
+
+	for (int i = p - 1; i >= 0; --i) {
+		auto [s2, t2] = anti_dfs_graph(w * w, (1 << i), n, sink);
+		sink.edge(x, s2, w * w * (1 << i));
+		vt.push_back(t2);
+	}
+
+	int t = ++n;
+
+	for (int t2 : vt) {
+		sink.edge(t2, t, inf);
+	}
+
+	assert(n == num_vertices(p, w));
+}
+
+} // namespace gen_anti_scaling_dfs
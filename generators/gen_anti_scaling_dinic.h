@@ -0,0 +1,181 @@
+/*
+ * Anti-Scaling-Dinic Graph Generator, library form.
+ * Description: generate(max_n, max_m, max_cap, seed, sink) passes the
+ *   graph that gen_anti_scaling_dinic.cpp prints to a sink (see common/graph_sink.h).
+ *   The graph does not depend on the seed.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
+#include "../common/search.h"
+
+namespace gen_anti_scaling_dinic {
+
+inline long long num_vertices(int k, int l, int p, int w) {
+	return 3LL + 2LL * w + p * (4LL * l + 2LL + 2LL * k);
+}
+
+inline long long num_edges(int k, int l, int p, int w) {
+	return 2 * w + 1LL * w * w + 2 * p + p * (6LL * l - 4LL + 4LL * k + 1LL * k * k);
+}
+
+inline long long max_capacity(int /*k*/, int /*l*/, int p, int w) {
+	return 1LL * w * w * ((1LL << p) - 1);
+}
+
+inline long long estimated_work(int k, int l, int p, int w) {
+	return 1LL * p * w * w * num_vertices(k, l, p, w);
+}
+
+// Largest l with ok(k, l, p, w), or 0 if there is none.
+inline long long max_length(int max_n, int max_m, int max_cap, long long k, int p, long long w) {
+	if (max_capacity(1, 1, p, w) > max_cap) return 0;
+	long long by_n = (max_n - 3LL - 2LL * w - p * (2LL + 2LL * k)) / (4LL * p);
+	long long by_m = (max_m - 2LL * w - w * w - 2LL * p - p * (k * k + 4LL * k - 4LL)) / (6LL * p);
+	return std::max(0LL, std::min(by_n, by_m));
+}
+
+// Smallest r with r * r >= x.
+inline long long ceil_sqrt(long long x) {
+	long long r = std::sqrt((long double) x);
+	while (r * r < x) r += 1;
+	while (r > 0 && (r - 1) * (r - 1) >= x) r -= 1;
+	return r;
+}
+
+inline std::array<int, 4> best_parameters(int max_n, int max_m, int max_cap) {
+	int best_k = 1;
+	int best_l = 1;
+	int best_p = 1;
+	int best_w = 1;
+
+	// Smallest k whose largest l gives k^2 l >= w^2. The largest l only
+	// shrinks as k grows, so with l for the current k no k below
+	// ceil(w / sqrt(l)) can work and the scan jumps there.
+	auto get_valid_kl = [&](int p, long long w) {
+		for (long long k = 1; ; ) {
+			long long l = max_length(max_n, max_m, max_cap, k, p, w);
+			if (l == 0) break;
+			if (k * k * l >= w * w) return std::make_pair((int) k, (int) l);
+			k = std::max(k + 1, ceil_sqrt((w * w + l - 1) / l));
+		}
+		return std::make_pair(-1, -1);
+	};
+
+	// A larger w makes every l smaller and needs a larger k^2 l, so the
+	// w that have a valid (k, l) form a prefix.
+	long long max_w = ceil_sqrt(std::max(max_m, 0) + 1LL);
+	for (int p = 1; p <= 29; ++p) {
+		int w = lastTrue(1, max_w, [&](long long x) { return get_valid_kl(p, x).first != -1; });
+		if (w == 0) break;
+		auto [k, l] = get_valid_kl(p, w);
+		if (estimated_work(k, l, p, w) > estimated_work(best_k, best_l, best_p, best_w)) {
+			best_k = k;
+			best_l = l;
+			best_p = p;
+			best_w = w;
+		}
+	}
+
+	return std::array<int, 4>{best_k, best_l, best_p, best_w};
+}
+
+template<class Sink>
+void generate(int max_n, int max_m, int max_cap, uint64_t /*seed*/, Sink& sink) {
+	assert(max_n >= 13);
+	assert(max_m >= 12);
+	assert(max_cap >= 1);
+
+	auto [k, l, p, w] = best_parameters(max_n, max_m, max_cap);
+
+	// Only the first ceil(w^2 / k^2) segments of every iteration carry
+	// flow, so the graph can have fewer edges than num_edges allows.
+	long long segments = std::min<long long>(l, (1LL * w * w + 1LL * k * k - 1) / (1LL * k * k));
+	long long m = 2LL * w + 1LL * w * w + p * (4LL * l - 2LL + 2LL * segments + 4LL * k + 1LL * k * k);
+
+	assert(m <= num_edges(k, l, p, w));
+
+	sink.begin(num_vertices(k, l, p, w), m, 1, num_vertices(k, l, p, w), max_cap);
+
+	int n = 0;
+
+	int s = ++n;
+	int x = ++n;
+
+	auto a = [&](int i) { return 3 + 2 * i; };
+	auto b = [&](int i) { return 4 + 2 * i; };
+	n += 2 * w;
+
+	for (int i = 0; i < w; ++i) {
+		sink.edge(s, a(i), max_cap);
+		sink.edge(b(i), x, max_cap);
+	}
+
+	for (int i = 0; i < w; ++i) {
+		for (int j = 0; j < w; ++j) {
+			sink.edge(a(i), b(j), (1 << p) - 1);
+		}
+	}
+
+	int t = num_vertices(k, l, p, w);
+
+	for (int iter = p - 1; iter >= 0; --iter) {
+		int unit = (1 << iter);
+
+		// Vertex ids of this iteration in the order they are created.
+		int base = n;
+		auto vs = [&](int i) { return base + 1 + i; };
+		int p1 = base + 2 * l;
+		int p2 = p1 + 1;
+		int q1 = p1 + 2;
+		int q2 = p1 + 3;
+		auto va = [&](int i) { return p1 + 4 + 2 * i; };
+		auto vb = [&](int i) { return p1 + 5 + 2 * i; };
+		auto vt = [&](int i) { return p1 + 4 + 2 * k + (2 * l - 2 - i); };
+		n += 4 * l + 2 + 2 * k;
+
+		for (int i = 0; i < 2 * l - 2; ++i) {
+			sink.edge(vs(i), vs(i + 1), max_cap);
+			sink.edge(vt(i + 1), vt(i), max_cap);
+		}
+
+		int need = w * w * unit;
+
+		for (int i = 0; i < 2 * l - 1; i += 2) {
+			int cap = std::min(k * k * unit, need);
+			if (cap >= 1) {
+				sink.edge(vs(i), (i % 4 == 0 ? p1 : p2), cap);
+				sink.edge((i % 4 == 0 ? q1 : q2), vt(i), cap);
+				need -= cap;
+			}
+		}
+
+		for (int i = 0; i < k; ++i) {
+			sink.edge(p1, va(i), max_cap);
+			sink.edge(p2, vb(i), max_cap);
+			sink.edge(va(i), q2, max_cap);
+			sink.edge(vb(i), q1, max_cap);
+		}
+
+		for (int i = 0; i < k; ++i) {
+			for (int j = 0; j < k; ++j) {
+				sink.edge(va(i), vb(j), unit);
+			}
+		}
+
+		sink.edge(x, vs(0), max_cap);
+		sink.edge(vt(0), t, max_cap);
+
+		x = vs(2 * l - 2);
+		t = vt(2 * l - 2);
+	}
+
+	assert(n + 1 == num_vertices(k, l, p, w));
+}
+
+} // namespace gen_anti_scaling_dinic
@@ -0,0 +1,104 @@
+/*
+ * Anti-Shortest-Augmenting-Paths Graph Generator, library form.
+ * Description: generate(max_n, max_m, max_cap, seed, sink) passes the
+ *   graph that gen_anti_shortest_paths.cpp prints to a sink (see common/graph_sink.h).
+ *   The graph does not depend on the seed.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+namespace gen_anti_shortest_paths {
+
+inline long long num_vertices(int k, int l) {
+	return 4LL * l + 2LL + 2LL * k;
+}
+
+inline long long num_edges(int k, int l) {
+	return 6LL * l - 4LL + 4LL * k + 1LL * k * k;
+}
+
+inline long long max_capacity(int k, int l) {
+	return 1LL * k * k * l;
+}
+
+inline long long num_augmenting_paths(int k, int l) {
+	return 1LL * k * k * l;
+}
+
+// Largest l with ok(k, l), or 0 if there is none.
+inline long long max_length(int max_n, int max_m, int max_cap, long long k) {
+	long long by_n = (max_n - 2LL - 2LL * k) / 4;
+	long long by_m = (max_m + 4LL - 4LL * k - k * k) / 6;
+	long long by_cap = max_cap / (k * k);
+	return std::max(0LL, std::min({by_n, by_m, by_cap}));
+}
+
+inline std::pair<int, int> best_parameters(int max_n, int max_m, int max_cap) {
+	int best_k = 1;
+	int best_l = 1;
+
+	// k^2 <= max_m, so there are at most sqrt(max_m) values of k.
+	for (long long k = 1; k <= max_n; ++k) {
+		long long l = max_length(max_n, max_m, max_cap, k);
+		if (l == 0) break;
+		if (num_augmenting_paths(k, l) > num_augmenting_paths(best_k, best_l)) {
+			best_k = k;
+			best_l = l;
+		}
+	}
+
+	return std::make_pair(best_k, best_l);
+}
+
+template<class Sink>
+void generate(int max_n, int max_m, int max_cap, uint64_t /*seed*/, Sink& sink) {
+	assert(max_n >= 7);
+	assert(max_m >= 5);
+	assert(max_cap >= 1);
+	assert(1LL * max_n * max_m <= 2'000'000'000LL); // avoid overflow
+
+	auto [k, l] = best_parameters(max_n, max_m, max_cap);
+	int flow = num_augmenting_paths(k, l);
+
+	int n = num_vertices(k, l);
+
+	// Vertex ids in the order the vertices are created.
+	auto s = [&](int i) { return 1 + i; };
+	int p1 = 2 * l;
+	int p2 = p1 + 1;
+	int q1 = p1 + 2;
+	int q2 = p1 + 3;
+	auto a = [&](int i) { return p1 + 4 + 2 * i; };
+	auto b = [&](int i) { return p1 + 5 + 2 * i; };
+	auto t = [&](int i) { return n - i; };
+
+	sink.begin(n, num_edges(k, l), 1, n, max_capacity(k, l));
+
+	for (int i = 0; i < 2 * l - 2; ++i) {
+		sink.edge(s(i), s(i + 1), flow);
+		sink.edge(t(i + 1), t(i), flow);
+	}
+
+	for (int i = 0; i < 2 * l - 1; i += 2) {
+		sink.edge(s(i), (i % 4 == 0 ? p1 : p2), k * k);
+		sink.edge((i % 4 == 0 ? q1 : q2), t(i), k * k);
+	}
+
+	for (int i = 0; i < k; ++i) {
+		sink.edge(p1, a(i), flow);
+		sink.edge(p2, b(i), flow);
+		sink.edge(a(i), q2, flow);
+		sink.edge(b(i), q1, flow);
+	}
+
+	for (int i = 0; i < k; ++i) {
+		for (int j = 0; j < k; ++j) {
+			sink.edge(a(i), b(j), 1);
+		}
+	}
+}
+
+} // namespace gen_anti_shortest_paths
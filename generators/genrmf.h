@@ -0,0 +1,119 @@
+/*
+ * Genrmf graph generator, library form.
+ * Description: generate(max_n, max_m, max_cap, seed, sink) passes the
+ *   graph that genrmf.cpp prints to a sink (see common/graph_sink.h).
+ *   The seed determines the random choices, so equal arguments give
+ *   equal graphs.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../common/search.h"
+
+namespace genrmf {
+
+inline long long num_vertices(int a, int b) {
+	return 1LL * a * a * b;
+}
+
+inline long long num_edges(int a, int b) {
+	return 4LL * a * (a - 1) * b + 2LL * a * a * (b - 1);
+}
+
+inline long long max_capacity(int a, int c2) {
+	return 1LL * a * a * c2;
+}
+
+inline std::array<int, 4> best_parameters(int max_n, int max_m, int max_cap) {
+	auto ok = [&](int a, int b, int c2) {
+		if (num_vertices(a, b) > max_n) return false;
+		if (num_edges(a, b) > max_m) return false;
+		if (max_capacity(a, c2) > max_cap) return false;
+		return true;
+	};
+
+	int c1 = 1;
+	int c2 = 1000;
+
+	int a = 2;
+	int b = 2;
+
+	// Grow a and b together, then a, then b, each as far as ok allows. ok is
+	// monotone in a and b, so every step is a binary search. The upper ends
+	// already exceed max_n vertices and keep the counts from overflowing.
+	int t = lastTrue(1, 1 << 11, [&](long long x) { return ok(a + x, b + x, c2); });
+	a += t;
+	b += t;
+
+	a = lastTrue(a + 1, 1 << 16, [&](long long x) { return ok(x, b, c2); });
+
+	b = lastTrue(b + 1, max_n / (1LL * a * a) + 1, [&](long long x) { return ok(a, x, c2); });
+
+	return std::array<int, 4>{a, b, c1, c2};
+}
+
+template<class Sink>
+void generate(int max_n, int max_m, int max_cap, uint64_t seed, Sink& sink) {
+	assert(max_n >= 8);
+	assert(max_m >= 24);
+	assert(max_cap >= 4000);
+
+	auto [a, b, c1, c2] = best_parameters(max_n, max_m, max_cap);
+
+	// Vertex (j, k) of frame i.
+	auto v = [&](int i, int j, int k) { return 1 + (i * a + j) * a + k; };
+
+	sink.begin(num_vertices(a, b), num_edges(a, b), 1, num_vertices(a, b), max_capacity(a, c2));
+
+	for (int i = 0; i < b; ++i) {
+		for (int j = 0; j < a; ++j) {
+			for (int k = 0; k < a; ++k) {
+				if (j + 1 < a) {
+					sink.edge(v(i, j, k), v(i, j + 1, k), a * a * c2);
+					sink.edge(v(i, j + 1, k), v(i, j, k), a * a * c2);
+				}
+				if (k + 1 < a) {
+					sink.edge(v(i, j, k), v(i, j, k + 1), a * a * c2);
+					sink.edge(v(i, j, k + 1), v(i, j, k), a * a * c2);
+				}
+			}
+		}
+	}
+
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> distr(c1, c2);
+
+	std::vector<std::pair<int, int>> perm(a * a);
+
+	for (int j = 0; j < a; ++j) {
+		for (int k = 0; k < a; ++k) {
+			perm[j * a + k].first = j;
+			perm[j * a + k].second = k;
+		}
+	}
+
+	for (int i = 0; i + 1 < b; ++i) {
+		std::shuffle(perm.begin(), perm.end(), rng);
+		for (int j = 0; j < a; ++j) {
+			for (int k = 0; k < a; ++k) {
+				auto [j2, k2] = perm[j * a + k];
+				sink.edge(v(i, j, k), v(i + 1, j2, k2), distr(rng));
+			}
+		}
+		std::shuffle(perm.begin(), perm.end(), rng);
+		for (int j = 0; j < a; ++j) {
+			for (int k = 0; k < a; ++k) {
+				auto [j2, k2] = perm[j * a + k];
+				sink.edge(v(i + 1, j2, k2), v(i, j, k), distr(rng));
+			}
+		}
+	}
+}
+
+} // namespace genrmf
@@ -0,0 +1,79 @@
+/*
+ * All generators by name.
+ * Description: GENERATORS lists the names of the generators, which are
+ *   also the names of their executables. withGenerator(name, f) calls
+ *   f(generate), where generate(max_n, max_m, max_cap, seed, sink) runs
+ *   that generator (see common/graph_sink.h), and returns false if there
+ *   is no generator of that name.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "ak.h"
+#include "gen_anti_dfs.h"
+#include "gen_anti_fifopp.h"
+#include "gen_anti_hipr.h"
+#include "gen_anti_hlpp.h"
+#include "gen_anti_most_improving.h"
+#include "gen_anti_random_dfs.h"
+#include "gen_anti_scaling_dfs.h"
+#include "gen_anti_scaling_dinic.h"
+#include "gen_anti_shortest_paths.h"
+#include "genrmf.h"
+
+const char* const GENERATORS[] = {
+	"ak",
+	"gen_anti_dfs",
+	"gen_anti_fifopp",
+	"gen_anti_hipr",
+	"gen_anti_hlpp",
+	"gen_anti_most_improving",
+	"gen_anti_random_dfs",
+	"gen_anti_scaling_dfs",
+	"gen_anti_scaling_dinic",
+	"gen_anti_shortest_paths",
+	"genrmf",
+};
+
+template<class F>
+bool withGenerator(const std::string& name, F&& f) {
+	if (name == "ak") {
+		f([](int max_n, int max_m, int max_cap, uint64_t seed, auto& sink) { ak::generate(max_n, max_m, max_cap, seed, sink); });
+	}
+	else if (name == "gen_anti_dfs") {
+		f([](int max_n, int max_m, int max_cap, uint64_t seed, auto& sink) { gen_anti_dfs::generate(max_n, max_m, max_cap, seed, sink); });
+	}
+	else if (name == "gen_anti_fifopp") {
+		f([](int max_n, int max_m, int max_cap, uint64_t seed, auto& sink) { gen_anti_fifopp::generate(max_n, max_m, max_cap, seed, sink); });
+	}
+	else if (name == "gen_anti_hipr") {
+		f([](int max_n, int max_m, int max_cap, uint64_t seed, auto& sink) { gen_anti_hipr::generate(max_n, max_m, max_cap, seed, sink); });
+	}
+	else if (name == "gen_anti_hlpp") {
+		f([](int max_n, int max_m, int max_cap, uint64_t seed, auto& sink) { gen_anti_hlpp::generate(max_n, max_m, max_cap, seed, sink); });
+	}
+	else if (name == "gen_anti_most_improving") {
+		f([](int max_n, int max_m, int max_cap, uint64_t seed, auto& sink) { gen_anti_most_improving::generate(max_n, max_m, max_cap, seed, sink); });
+	}
+	else if (name == "gen_anti_random_dfs") {
+		f([](int max_n, int max_m, int max_cap, uint64_t seed, auto& sink) { gen_anti_random_dfs::generate(max_n, max_m, max_cap, seed, sink); });
+	}
+	else if (name == "gen_anti_scaling_dfs") {
+		f([](int max_n, int max_m, int max_cap, uint64_t seed, auto& sink) { gen_anti_scaling_dfs::generate(max_n, max_m, max_cap, seed, sink); });
+	}
+	else if (name == "gen_anti_scaling_dinic") {
+		f([](int max_n, int max_m, int max_cap, uint64_t seed, auto& sink) { gen_anti_scaling_dinic::generate(max_n, max_m, max_cap, seed, sink); });
+	}
+	else if (name == "gen_anti_shortest_paths") {
+		f([](int max_n, int max_m, int max_cap, uint64_t seed, auto& sink) { gen_anti_shortest_paths::generate(max_n, max_m, max_cap, seed, sink); });
+	}
+	else if (name == "genrmf") {
+		f([](int max_n, int max_m, int max_cap, uint64_t seed, auto& sink) { genrmf::generate(max_n, max_m, max_cap, seed, sink); });
+	}
+	else {
+		return false;
+	}
+	return true;
+}
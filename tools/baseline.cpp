@@ -0,0 +1,278 @@
+/*
+ * Performance Baseline
+ * Description: Turns benchmark results (the csv output of benchmark.cpp)
+ *   into a baseline and compares later results with it. A baseline has a
+ *   line per (generator, max_n, max_m, solver) cell with the number of
+ *   runs, the median and median absolute deviation of the solve time, the
+ *   median build time, the median arena bytes and peak resident set size,
+ *   the median of every operation count (if the benchmark was built with
+ *   -DMAXFLOW_COUNTERS) and the solve times themselves, separated by ';'.
+ *   Comparing tests every cell with a one-sided Mann-Whitney U test over
+ *   the runs (see common/statistics.h). A cell is slower (faster) if the
+ *   p-value is at most alpha and the medians differ by more than
+ *   min-change. A cell with too few runs for the p-value to reach alpha
+ *   cannot be tested and is reported as untested. Next to the time it
+ *   shows the time per operation, nanoseconds per arc scanned and per
+ *   push, and whether the operation counts changed: a slowdown with equal
+ *   counts comes from the code or memory layout, one with more work from
+ *   the algorithm. Runs with equal seeds make equal choices, so the
+ *   counts of a cell do not vary. A cell is bigger if its arena bytes or
+ *   peak resident set size grew by more than min-change.
+ * Usage: baseline [results.csv] > baseline.csv
+ *        baseline --compare=baseline.csv [--alpha=A] [--min-change=C]
+ *          [results.csv]
+ *   Results are read from standard input if no file is given. alpha
+ *   defaults to 0.05 and min-change to 0.05 (5%), which takes at least 3
+ *   runs per cell on both sides. Compare exits with status 1 if a cell
+ *   got slower or bigger or is untested.
+ */
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "../common/arena.h"
+#include "../common/counters.h"
+#include "../common/options.h"
+#include "../common/statistics.h"
+
+using Key = std::tuple<std::string, int, int, std::string>;
+
+struct Cell {
+	std::vector<double> solve_seconds, build_seconds, allocated_bytes, peak_rss_bytes;
+	// Counter name to the values of the runs, empty without counters.
+	std::map<std::string, std::vector<double>> counts;
+};
+
+struct Summary {
+	int runs;
+	double solve_median, solve_mad, build_median;
+	double allocated_bytes, peak_rss_bytes;
+	std::map<std::string, double> counts;
+	std::vector<double> solve_seconds;
+};
+
+std::vector<std::string> split(const std::string& line, char separator) {
+	std::vector<std::string> fields;
+	std::string field;
+	std::istringstream in(line);
+	while (std::getline(in, field, separator)) fields.push_back(field);
+	if (!line.empty() && line.back() == separator) fields.push_back("");
+	return fields;
+}
+
+std::vector<std::string> counterNames() {
+	std::vector<std::string> names;
+	OperationCounts().forEach([&](const char* name, long long) { names.push_back(name); });
+	return names;
+}
+
+// Reads csv with a header line into rows of column name to value.
+std::vector<std::map<std::string, std::string>> readCsv(std::istream& in) {
+	std::vector<std::map<std::string, std::string>> rows;
+	std::string line;
+	if (!std::getline(in, line)) return rows;
+	std::vector<std::string> header = split(line, ',');
+	while (std::getline(in, line)) {
+		if (line.empty()) continue;
+		std::vector<std::string> fields = split(line, ',');
+		std::map<std::string, std::string> row;
+		for (size_t i = 0; i < header.size() && i < fields.size(); ++i) row[header[i]] = fields[i];
+		rows.push_back(row);
+	}
+	return rows;
+}
+
+Key keyOf(std::map<std::string, std::string>& row) {
+	return Key(row["generator"], std::atoi(row["max_n"].c_str()), std::atoi(row["max_m"].c_str()), row["solver"]);
+}
+
+// Groups the finished runs of benchmark results by cell.
+std::map<Key, Cell> readResults(std::istream& in) {
+	std::map<Key, Cell> cells;
+	for (auto& row : readCsv(in)) {
+		if (row["status"] != "ok") continue;
+		Cell& cell = cells[keyOf(row)];
+		cell.solve_seconds.push_back(std::atof(row["solve_seconds"].c_str()));
+		cell.build_seconds.push_back(std::atof(row["build_seconds"].c_str()));
+		double allocated = 0;
+		for (int i = 0; i < NUM_USES; ++i) allocated += std::atof(row[std::string(useName((Use) i)) + "_bytes"].c_str());
+		cell.allocated_bytes.push_back(allocated);
+		cell.peak_rss_bytes.push_back(std::atof(row["peak_rss_bytes"].c_str()));
+		for (const std::string& name : counterNames()) {
+			auto it = row.find(name);
+			if (it != row.end() && !it->second.empty()) cell.counts[name].push_back(std::atof(it->second.c_str()));
+		}
+	}
+	return cells;
+}
+
+Summary summarize(const Cell& cell) {
+	Summary s;
+	s.runs = (int) cell.solve_seconds.size();
+	s.solve_median = median(cell.solve_seconds);
+	s.solve_mad = medianAbsoluteDeviation(cell.solve_seconds);
+	s.build_median = median(cell.build_seconds);
+	s.allocated_bytes = median(cell.allocated_bytes);
+	s.peak_rss_bytes = median(cell.peak_rss_bytes);
+	for (auto& [name, values] : cell.counts) s.counts[name] = median(values);
+	s.solve_seconds = cell.solve_seconds;
+	return s;
+}
+
+std::map<Key, Summary> readBaseline(std::istream& in) {
+	std::map<Key, Summary> baseline;
+	for (auto& row : readCsv(in)) {
+		Summary& s = baseline[keyOf(row)];
+		s.runs = std::atoi(row["runs"].c_str());
+		s.solve_median = std::atof(row["solve_median"].c_str());
+		s.solve_mad = std::atof(row["solve_mad"].c_str());
+		s.build_median = std::atof(row["build_median"].c_str());
+		s.allocated_bytes = std::atof(row["allocated_bytes"].c_str());
+		s.peak_rss_bytes = std::atof(row["peak_rss_bytes"].c_str());
+		for (const std::string& name : counterNames()) {
+			auto it = row.find(name);
+			if (it != row.end() && !it->second.empty()) s.counts[name] = std::atof(it->second.c_str());
+		}
+		for (const std::string& value : split(row["solve_samples"], ';')) {
+			if (!value.empty()) s.solve_seconds.push_back(std::atof(value.c_str()));
+		}
+	}
+	return baseline;
+}
+
+void writeBaseline(const std::map<Key, Cell>& cells) {
+	std::vector<std::string> names = counterNames();
+	std::printf("generator,max_n,max_m,solver,runs,solve_median,solve_mad,build_median,allocated_bytes,peak_rss_bytes,");
+	for (const std::string& name : names) std::printf("%s,", name.c_str());
+	std::printf("solve_samples\n");
+	for (auto& [key, cell] : cells) {
+		auto& [generator, max_n, max_m, solver] = key;
+		Summary s = summarize(cell);
+		std::printf("%s,%d,%d,%s,%d,%.9f,%.9f,%.9f,%.0f,%.0f,", generator.c_str(), max_n, max_m, solver.c_str(),
+			s.runs, s.solve_median, s.solve_mad, s.build_median, s.allocated_bytes, s.peak_rss_bytes);
+		for (const std::string& name : names) {
+			if (s.counts.count(name)) std::printf("%.0f", s.counts[name]);
+			std::printf(",");
+		}
+		for (size_t i = 0; i < s.solve_seconds.size(); ++i) std::printf("%s%.9f", i ? ";" : "", s.solve_seconds[i]);
+		std::printf("\n");
+	}
+}
+
+// Nanoseconds of solve time per operation, or NAN without counts.
+double nsPer(const Summary& s, std::initializer_list<const char*> counters) {
+	double operations = 0;
+	for (const char* name : counters) {
+		auto it = s.counts.find(name);
+		if (it == s.counts.end()) return NAN;
+		operations += it->second;
+	}
+	return operations > 0 ? s.solve_median * 1e9 / operations : NAN;
+}
+
+std::string formatNs(double before, double after) {
+	if (std::isnan(before) || std::isnan(after)) return "-";
+	char text[64];
+	std::snprintf(text, sizeof(text), "%.2f>%.2f", before, after);
+	return text;
+}
+
+// Relative change, or 0 if there is no baseline value.
+double relativeChange(double before, double after) {
+	return before > 0 ? after / before - 1 : 0;
+}
+
+// Returns the number of cells that got slower or bigger or are untested.
+int compare(const std::map<Key, Summary>& baseline, const std::map<Key, Cell>& cells, double alpha, double min_change) {
+	std::printf("%-28s %8s %8s %-16s %12s %12s %8s %9s %17s %17s %-12s %8s %8s %s\n", "generator", "max_n", "max_m", "solver",
+		"base_s", "new_s", "change", "p", "ns/arc", "ns/push", "work", "arena", "rss", "verdict");
+	int regressions = 0, untested = 0;
+	for (auto& [key, cell] : cells) {
+		auto& [generator, max_n, max_m, solver] = key;
+		Summary now = summarize(cell);
+		auto it = baseline.find(key);
+		if (it == baseline.end()) {
+			std::printf("%-28s %8d %8d %-16s %12s %12.6f %8s %9s %17s %17s %-12s %8s %8s %s\n", generator.c_str(), max_n, max_m, solver.c_str(),
+				"-", now.solve_median, "-", "-", "-", "-", "-", "-", "-", "new");
+			continue;
+		}
+		const Summary& base = it->second;
+
+		double change = now.solve_median / base.solve_median - 1;
+		double p_slower = mannWhitneyGreater(base.solve_seconds, now.solve_seconds);
+		double p_faster = mannWhitneyGreater(now.solve_seconds, base.solve_seconds);
+		std::string verdict = "same";
+		double p = std::min(p_slower, p_faster);
+		if (mannWhitneySmallestP((int) base.solve_seconds.size(), (int) now.solve_seconds.size()) > alpha) {
+			verdict = "untested";
+			++untested;
+		}
+		else if (p_slower <= alpha && change > min_change) verdict = "slower";
+		else if (p_faster <= alpha && change < -min_change) verdict = "faster";
+
+		double arena_change = relativeChange(base.allocated_bytes, now.allocated_bytes);
+		double rss_change = relativeChange(base.peak_rss_bytes, now.peak_rss_bytes);
+		bool bigger = arena_change > min_change || rss_change > min_change;
+		if (bigger) verdict = verdict == "same" ? "bigger" : verdict + ",bigger";
+		if (verdict.find("slower") != std::string::npos || bigger) ++regressions;
+
+		// Equal counts mean equal work, so a change in time is not algorithmic.
+		std::string work = "-";
+		if (!base.counts.empty() && !now.counts.empty()) {
+			work = "equal";
+			for (auto& [name, value] : now.counts) {
+				auto b = base.counts.find(name);
+				if (b == base.counts.end() || b->second != value) work = "changed";
+			}
+			if (work == "changed" && base.counts.count("arcs_scanned") && base.counts.at("arcs_scanned") > 0) {
+				char text[32];
+				std::snprintf(text, sizeof(text), "arcs%+.1f%%", 100 * (now.counts["arcs_scanned"] / base.counts.at("arcs_scanned") - 1));
+				work = text;
+			}
+		}
+
+		std::printf("%-28s %8d %8d %-16s %12.6f %12.6f %+7.1f%% %9.2g %17s %17s %-12s %+7.1f%% %+7.1f%% %s\n", generator.c_str(), max_n, max_m, solver.c_str(),
+			base.solve_median, now.solve_median, 100 * change, p,
+			formatNs(nsPer(base, {"arcs_scanned"}), nsPer(now, {"arcs_scanned"})).c_str(),
+			formatNs(nsPer(base, {"saturating_pushes", "nonsaturating_pushes"}), nsPer(now, {"saturating_pushes", "nonsaturating_pushes"})).c_str(),
+			work.c_str(), 100 * arena_change, 100 * rss_change, verdict.c_str());
+	}
+	if (regressions > 0) std::fprintf(stderr, "%d cells got slower or bigger\n", regressions);
+	if (untested > 0) std::fprintf(stderr, "%d cells have too few runs to be significant at alpha %g\n", untested, alpha);
+	return regressions + untested;
+}
+
+int main(int argc, char* argv[]) {
+	const char* input = getPositional(argc, argv);
+	std::ifstream file;
+	if (input) {
+		file.open(input);
+		if (!file) {
+			std::fprintf(stderr, "cannot open %s\n", input);
+			return 2;
+		}
+	}
+	std::map<Key, Cell> cells = readResults(input ? file : std::cin);
+
+	const char* baseline_path = getOption(argc, argv, "compare");
+	if (!baseline_path) {
+		writeBaseline(cells);
+		return 0;
+	}
+
+	std::ifstream baseline_file(baseline_path);
+	if (!baseline_file) {
+		std::fprintf(stderr, "cannot open %s\n", baseline_path);
+		return 2;
+	}
+	double alpha = std::atof(getOption(argc, argv, "alpha", "0.05"));
+	double min_change = std::atof(getOption(argc, argv, "min-change", "0.05"));
+	return compare(readBaseline(baseline_file), cells, alpha, min_change) > 0 ? 1 : 0;
+}
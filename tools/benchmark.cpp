@@ -0,0 +1,262 @@
+/*
+ * Benchmark Driver
+ * Description: Runs generators against solvers in-process, so neither
+ *   formatting nor parsing of instances is measured. For every run it
+ *   records the build time (generating the instance straight into the
+ *   residual graph, see common/solver_sink.h), the solve time alone and
+ *   the flow value. Each (generator, size, solver) cell runs in a forked
+ *   child: a timeout, a crash or a failed assertion only loses that cell.
+ *   Within a cell the arena is reused, so warmups also warm up memory.
+ * Usage: benchmark [options] > results.csv
+ *   --generators=a,b,...  generators to run (default: all, see generators/registry.h)
+ *   --solvers=a,b,...     solvers to run (default: all, see algorithms/registry.h)
+ *   --sizes=n:m,...       max_n:max_m pairs (default: 1000:3000,10000:30000,100000:300000)
+ *   --max-cap=C           capacity bound passed to the generators (default: 1000000000)
+ *   --seed=S              seed of the generators and solvers (default: 0)
+ *   --warmup=W            unrecorded runs per cell (default: 1)
+ *   --repeat=R            recorded runs per cell (default: 3)
+ *   --timeout=T           seconds per cell, warmups included (default: 60)
+ *   --cpu=C               pin the runs to CPU C (default: no pinning)
+ *   --format=csv|json     output format (default: csv)
+ *   Every recorded run gives one record with the fields generator, max_n,
+ *   max_m, solver, run, n, m, flow, build_seconds, solve_seconds, the
+ *   arena bytes by use arcs_bytes, vertices_bytes and queues_bytes (see
+ *   common/arena.h), bytes_per_edge (all arena bytes over m),
+ *   peak_rss_bytes of the cell's process and status (ok, timeout or
+ *   error). Runs that did not finish have empty
+ *   (csv) or null (json) values. Built with -DMAXFLOW_COUNTERS, every
+ *   record also has the operation counts of the run (see
+ *   common/counters.h), at the price of slightly slower solvers.
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sched.h>
+
+#include "../algorithms/registry.h"
+#include "../common/arena.h"
+#include "../common/forked_run.h"
+#include "../common/memory_usage.h"
+#include "../common/options.h"
+#include "../common/solver_sink.h"
+#include "../generators/registry.h"
+
+struct Config {
+	int max_cap;
+	uint64_t seed;
+	int warmup, repeat;
+	double timeout;
+	int cpu;
+	bool json;
+};
+
+struct Run {
+	long long n, m, flow;
+	double build_seconds, solve_seconds;
+	long long bytes[NUM_USES];
+	long long peak_rss;
+	std::vector<long long> counts;
+
+	double bytesPerEdge() const {
+		long long total = 0;
+		for (long long b : bytes) total += b;
+		return m > 0 ? (double) total / m : 0;
+	}
+};
+
+std::vector<const char*> counterNames() {
+	std::vector<const char*> names;
+	if (COUNTERS_ENABLED) OperationCounts().forEach([&](const char* name, long long) { names.push_back(name); });
+	return names;
+}
+
+// Runs one cell and writes a line per recorded run to fd.
+template<template<class> class Solver, class Generate>
+void runCell(SolverTag<Solver>, Generate& generate, int max_n, int max_m, const Config& config, int fd) {
+	using Clock = std::chrono::steady_clock;
+	auto configure = [&](auto& g) { setSeed(g, config.seed); };
+	Arena arena;
+	for (int run = -config.warmup; run < config.repeat; ++run) {
+		arena.reset();
+		SolverSink<Solver, decltype(configure)> sink(arena, configure);
+		SizeRecorder<decltype(sink)> recorder{sink, 0, 0};
+
+		Clock::time_point start = Clock::now();
+		generate(max_n, max_m, config.max_cap, config.seed, recorder);
+		generate(max_n, max_m, config.max_cap, config.seed, recorder);
+		sink.build();
+		Clock::time_point built = Clock::now();
+		long long flow = sink.flow();
+		Clock::time_point solved = Clock::now();
+
+		if (run < 0) continue;
+		std::string line = std::to_string(recorder.n) + ' ' + std::to_string(recorder.m) + ' ' + std::to_string(flow);
+		char times[64];
+		std::snprintf(times, sizeof(times), " %.9f %.9f",
+			std::chrono::duration<double>(built - start).count(),
+			std::chrono::duration<double>(solved - built).count());
+		line += times;
+		for (int i = 0; i < NUM_USES; ++i) line += ' ' + std::to_string(arena.allocated((Use) i));
+		line += ' ' + std::to_string(peakRss());
+		if (COUNTERS_ENABLED) sink.counts().forEach([&](const char*, long long value) { line += ' ' + std::to_string(value); });
+		dprintf(fd, "%s\n", line.c_str());
+	}
+}
+
+// Runs a cell in a child process. Returns the finished runs and sets
+// status to "ok", "timeout" or "error".
+std::vector<Run> measure(const std::string& generator, const std::string& solver, int max_n, int max_m, const Config& config, const char*& status) {
+	ForkedRun child = runForked([&](int fd) {
+		if (config.cpu >= 0) {
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			CPU_SET(config.cpu, &set);
+			if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+				std::perror("sched_setaffinity");
+				return 1;
+			}
+		}
+		try {
+			withGenerator(generator, [&](auto generate) {
+				withSolver(solver, [&](auto tag) {
+					runCell(tag, generate, max_n, max_m, config, fd);
+				});
+			});
+		}
+		catch (const std::exception& e) {
+			std::fprintf(stderr, "%s on %s %d %d: %s\n", solver.c_str(), generator.c_str(), max_n, max_m, e.what());
+			return 1;
+		}
+		return 0;
+	}, config.timeout);
+	const std::string& output = child.output;
+
+	std::vector<Run> runs;
+	size_t num_counts = counterNames().size();
+	size_t begin = 0, end;
+	while ((end = output.find('\n', begin)) != std::string::npos) {
+		Run r;
+		std::istringstream line(output.substr(begin, end - begin));
+		line >> r.n >> r.m >> r.flow >> r.build_seconds >> r.solve_seconds;
+		for (long long& b : r.bytes) line >> b;
+		line >> r.peak_rss;
+		r.counts.resize(num_counts);
+		for (long long& count : r.counts) line >> count;
+		if (line) runs.push_back(r);
+		begin = end + 1;
+	}
+
+	status = child.status;
+	if (std::strcmp(status, "ok") == 0 && (int) runs.size() != config.repeat) status = "error";
+	return runs;
+}
+
+int main(int argc, char* argv[]) {
+	std::vector<std::string> generators, solvers;
+	for (const char* name : GENERATORS) generators.push_back(name);
+	for (const char* name : SOLVERS) solvers.push_back(name);
+	if (const char* list = getOption(argc, argv, "generators")) generators = split(list);
+	if (const char* list = getOption(argc, argv, "solvers")) solvers = split(list);
+
+	std::vector<std::pair<int, int>> sizes;
+	for (const std::string& size : split(getOption(argc, argv, "sizes", "1000:3000,10000:30000,100000:300000"))) {
+		int max_n, max_m;
+		if (std::sscanf(size.c_str(), "%d:%d", &max_n, &max_m) != 2) {
+			std::fprintf(stderr, "bad size %s, expected max_n:max_m\n", size.c_str());
+			return 2;
+		}
+		sizes.emplace_back(max_n, max_m);
+	}
+
+	Config config;
+	config.max_cap = std::atoi(getOption(argc, argv, "max-cap", "1000000000"));
+	config.seed = std::strtoull(getOption(argc, argv, "seed", "0"), nullptr, 10);
+	config.warmup = std::atoi(getOption(argc, argv, "warmup", "1"));
+	config.repeat = std::atoi(getOption(argc, argv, "repeat", "3"));
+	config.timeout = std::atof(getOption(argc, argv, "timeout", "60"));
+	config.cpu = std::atoi(getOption(argc, argv, "cpu", "-1"));
+	config.json = std::strcmp(getOption(argc, argv, "format", "csv"), "json") == 0;
+
+	for (const std::string& name : generators) {
+		if (!withGenerator(name, [](auto) {})) {
+			std::fprintf(stderr, "unknown generator %s\n", name.c_str());
+			return 2;
+		}
+	}
+	for (const std::string& name : solvers) {
+		if (!withSolver(name, [](auto) {})) {
+			std::fprintf(stderr, "unknown solver %s\n", name.c_str());
+			return 2;
+		}
+	}
+
+	std::vector<const char*> counters = counterNames();
+	if (config.json) std::printf("[");
+	else {
+		std::printf("generator,max_n,max_m,solver,run,n,m,flow,build_seconds,solve_seconds,");
+		for (int i = 0; i < NUM_USES; ++i) std::printf("%s_bytes,", useName((Use) i));
+		std::printf("bytes_per_edge,peak_rss_bytes,");
+		for (const char* name : counters) std::printf("%s,", name);
+		std::printf("status\n");
+	}
+	bool first = true;
+	for (const std::string& generator : generators) {
+		for (auto [max_n, max_m] : sizes) {
+			for (const std::string& solver : solvers) {
+				const char* status;
+				std::vector<Run> runs = measure(generator, solver, max_n, max_m, config, status);
+				for (int i = 0; i < config.repeat; ++i) {
+					bool done = i < (int) runs.size();
+					const char* run_status = done ? "ok" : status;
+					if (config.json) {
+						std::printf("%s\n  {\"generator\": \"%s\", \"max_n\": %d, \"max_m\": %d, \"solver\": \"%s\", \"run\": %d, ",
+							first ? "" : ",", generator.c_str(), max_n, max_m, solver.c_str(), i);
+						if (done) {
+							const Run& r = runs[i];
+							std::printf("\"n\": %lld, \"m\": %lld, \"flow\": %lld, \"build_seconds\": %.9f, \"solve_seconds\": %.9f, ",
+								r.n, r.m, r.flow, r.build_seconds, r.solve_seconds);
+							for (int j = 0; j < NUM_USES; ++j) std::printf("\"%s_bytes\": %lld, ", useName((Use) j), r.bytes[j]);
+							std::printf("\"bytes_per_edge\": %.2f, \"peak_rss_bytes\": %lld, ", r.bytesPerEdge(), r.peak_rss);
+							for (size_t j = 0; j < counters.size(); ++j) std::printf("\"%s\": %lld, ", counters[j], r.counts[j]);
+						}
+						else {
+							std::printf("\"n\": null, \"m\": null, \"flow\": null, \"build_seconds\": null, \"solve_seconds\": null, ");
+							for (int j = 0; j < NUM_USES; ++j) std::printf("\"%s_bytes\": null, ", useName((Use) j));
+							std::printf("\"bytes_per_edge\": null, \"peak_rss_bytes\": null, ");
+							for (const char* name : counters) std::printf("\"%s\": null, ", name);
+						}
+						std::printf("\"status\": \"%s\"}", run_status);
+					}
+					else {
+						std::printf("%s,%d,%d,%s,%d,", generator.c_str(), max_n, max_m, solver.c_str(), i);
+						if (done) {
+							const Run& r = runs[i];
+							std::printf("%lld,%lld,%lld,%.9f,%.9f,", r.n, r.m, r.flow, r.build_seconds, r.solve_seconds);
+							for (long long b : r.bytes) std::printf("%lld,", b);
+							std::printf("%.2f,%lld,", r.bytesPerEdge(), r.peak_rss);
+							for (long long count : r.counts) std::printf("%lld,", count);
+						}
+						else {
+							std::printf(",,,,,");
+							for (int j = 0; j < NUM_USES; ++j) std::printf(",");
+							std::printf(",,");
+							for (size_t j = 0; j < counters.size(); ++j) std::printf(",");
+						}
+						std::printf("%s\n", run_status);
+					}
+					first = false;
+				}
+				std::fflush(stdout);
+			}
+		}
+	}
+	if (config.json) std::printf("\n]\n");
+	return 0;
+}
@@ -0,0 +1,206 @@
+/*
+ * Lower-Bound Conformance Suite
+ * Description: Checks that every generator still forces the work it claims
+ *   on the solver it targets. Each case generates the instance at a ladder
+ *   of sizes, solves it in-process with operation counters enabled (see
+ *   common/counters.h) and compares one counter with the generator's own
+ *   formula (num_augmenting_paths, estimated_work, ...). A case fails if
+ *   measured / claimed drops below the case's minimum ratio at any size,
+ *   or if the log-log slope of the measured counts against max_m falls
+ *   more than the tolerance below the slope of the claims, i.e. if the
+ *   generator stops growing the work as fast as it promises.
+ *   gen_anti_hipr is not checked: it targets hi_pr.c, which is not in this
+ *   repository, and is not a worst case for hlpp_heuristic.
+ * Usage: conformance [--cases=gen_a,gen_b,...] [--tolerance=T]
+ *   cases selects cases by generator (default: all), tolerance is the
+ *   allowed slope deficit (default: 0.15, since lower-order terms still
+ *   show at the small sizes that keep the suite fast). Exits with status 1
+ *   if a case fails.
+ */
+#ifndef MAXFLOW_COUNTERS
+#define MAXFLOW_COUNTERS
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../algorithms/registry.h"
+#include "../common/arena.h"
+#include "../common/options.h"
+#include "../common/solver_sink.h"
+#include "../generators/registry.h"
+
+struct Instance {
+	int max_n, max_m, max_cap;
+	long long n, m;
+};
+
+struct Case {
+	const char* generator;
+	const char* solver;
+	const char* counter;
+	const char* claim;
+	double (*claimed)(const Instance&);
+	double min_ratio;
+	std::vector<std::pair<int, int>> sizes;
+};
+
+const int MAX_CAP = 1000000000;
+const uint64_t SEED = 1;
+
+const std::vector<Case> CASES = {
+	{"gen_anti_shortest_paths", "edmonds_karp", "augmenting_paths", "num_augmenting_paths",
+		[](const Instance& x) {
+			auto [k, l] = gen_anti_shortest_paths::best_parameters(x.max_n, x.max_m, x.max_cap);
+			return (double) gen_anti_shortest_paths::num_augmenting_paths(k, l);
+		}, 1.0, {{100, 300}, {200, 600}, {400, 1200}, {800, 2400}}},
+	{"gen_anti_shortest_paths", "dinic", "augmenting_paths", "num_augmenting_paths",
+		[](const Instance& x) {
+			auto [k, l] = gen_anti_shortest_paths::best_parameters(x.max_n, x.max_m, x.max_cap);
+			return (double) gen_anti_shortest_paths::num_augmenting_paths(k, l);
+		}, 1.0, {{100, 300}, {200, 600}, {400, 1200}, {800, 2400}}},
+	{"gen_anti_scaling_dfs", "scaling_dfs", "augmenting_paths", "num_augmenting_paths",
+		[](const Instance& x) {
+			auto [p, w] = gen_anti_scaling_dfs::best_parameters(x.max_n, x.max_m, x.max_cap);
+			return (double) gen_anti_scaling_dfs::num_augmenting_paths(p, w);
+		}, 1.0, {{250, 750}, {500, 1500}, {1000, 3000}, {2000, 6000}}},
+	{"gen_anti_scaling_dinic", "scaling_dinic", "augmenting_paths", "p w^2",
+		[](const Instance& x) {
+			auto [k, l, p, w] = gen_anti_scaling_dinic::best_parameters(x.max_n, x.max_m, x.max_cap);
+			return (double) p * w * w;
+		}, 1.0, {{500, 1500}, {1000, 3000}, {2000, 6000}, {4000, 12000}}},
+	{"gen_anti_scaling_dinic", "scaling_dinic", "arcs_scanned", "estimated_work",
+		[](const Instance& x) {
+			auto [k, l, p, w] = gen_anti_scaling_dinic::best_parameters(x.max_n, x.max_m, x.max_cap);
+			return (double) gen_anti_scaling_dinic::estimated_work(k, l, p, w);
+		}, 0.1, {{500, 1500}, {1000, 3000}, {2000, 6000}, {4000, 12000}}},
+	{"gen_anti_hlpp", "hlpp", "nonsaturating_pushes", "estimated_work",
+		[](const Instance& x) {
+			auto [K, W, L] = gen_anti_hlpp::best_parameters(x.max_n, x.max_m, x.max_cap);
+			return (double) gen_anti_hlpp::estimated_work(K, W, L);
+		}, 0.5, {{500, 1500}, {1000, 3000}, {2000, 6000}, {4000, 12000}, {8000, 24000}}},
+	// n = 10 k for k pairs of paths.
+	{"gen_anti_fifopp", "fifopp", "nonsaturating_pushes", "k^3, k = n / 10",
+		[](const Instance& x) {
+			return std::pow((double) (x.n / 10), 3);
+		}, 1.0, {{250, 750}, {500, 1500}, {1000, 3000}, {2000, 6000}}},
+	{"gen_anti_most_improving", "most_improving", "augmenting_paths", "n",
+		[](const Instance& x) {
+			return (double) x.n;
+		}, 1.0, {{250, 750}, {500, 1500}, {1000, 3000}, {2000, 6000}}},
+	// n = 2 i + 1 for i iterations.
+	{"gen_anti_dfs", "dfs", "augmenting_paths", "2^i, i = (n - 1) / 2",
+		[](const Instance& x) {
+			return std::pow(2.0, (double) ((x.n - 1) / 2));
+		}, 1.0, {{10, 20}, {16, 32}, {24, 48}, {32, 64}}},
+	{"gen_anti_random_dfs", "random_dfs", "augmenting_paths", "num_augmenting_paths",
+		[](const Instance& x) {
+			auto [i, k] = gen_anti_random_dfs::best_parameters(x.max_n, x.max_m, x.max_cap);
+			return (double) gen_anti_random_dfs::num_augmenting_paths(i, k);
+		}, 1.0, {{100, 200}, {200, 400}, {300, 600}, {400, 800}}},
+};
+
+template<template<class> class Solver, class Generate>
+OperationCounts measure(SolverTag<Solver>, Generate& generate, Instance& x, Arena& arena) {
+	auto configure = [](auto& g) { setSeed(g, SEED); };
+	SolverSink<Solver, decltype(configure)> sink(arena, configure);
+	SizeRecorder<decltype(sink)> recorder{sink, 0, 0};
+	generate(x.max_n, x.max_m, x.max_cap, SEED, recorder);
+	generate(x.max_n, x.max_m, x.max_cap, SEED, recorder);
+	sink.flow();
+	x.n = recorder.n;
+	x.m = recorder.m;
+	return sink.counts();
+}
+
+long long counterValue(const OperationCounts& counts, const char* name) {
+	long long result = -1;
+	counts.forEach([&](const char* counter, long long value) {
+		if (std::strcmp(counter, name) == 0) result = value;
+	});
+	return result;
+}
+
+// Least-squares slope of log y over log x.
+double logLogSlope(const std::vector<double>& x, const std::vector<double>& y) {
+	int k = (int) x.size();
+	double sx = 0, sy = 0, sxx = 0, sxy = 0;
+	for (int i = 0; i < k; ++i) {
+		double lx = std::log(x[i]), ly = std::log(y[i]);
+		sx += lx;
+		sy += ly;
+		sxx += lx * lx;
+		sxy += lx * ly;
+	}
+	return (k * sxy - sx * sy) / (k * sxx - sx * sx);
+}
+
+// Runs a case, prints its table and returns whether it passed.
+bool check(const Case& c, double tolerance) {
+	std::printf("%s / %s: %s >= %g * %s\n", c.generator, c.solver, c.counter, c.min_ratio, c.claim);
+	std::printf("  %8s %8s %8s %8s %14s %14s %8s\n", "max_n", "max_m", "n", "m", "measured", "claimed", "ratio");
+	std::fflush(stdout);
+
+	bool ok = true;
+	std::vector<double> sizes, measured, claimed;
+	Arena arena;
+	for (auto [max_n, max_m] : c.sizes) {
+		Instance x = {max_n, max_m, MAX_CAP, 0, 0};
+		OperationCounts counts;
+		withGenerator(c.generator, [&](auto generate) {
+			withSolver(c.solver, [&](auto tag) {
+				counts = measure(tag, generate, x, arena);
+			});
+		});
+		arena.reset();
+		double value = (double) counterValue(counts, c.counter);
+		double claim = c.claimed(x);
+		double ratio = value / claim;
+		bool below = ratio < c.min_ratio;
+		ok &= !below;
+		std::printf("  %8d %8d %8lld %8lld %14.0f %14.0f %8.3f%s\n", max_n, max_m, x.n, x.m, value, claim, ratio, below ? "  below" : "");
+		std::fflush(stdout);
+		sizes.push_back(max_m);
+		measured.push_back(std::max(value, 1.0));
+		claimed.push_back(claim);
+	}
+
+	double measured_slope = logLogSlope(sizes, measured);
+	double claimed_slope = logLogSlope(sizes, claimed);
+	bool slow = measured_slope < claimed_slope - tolerance;
+	ok &= !slow;
+	std::printf("  exponent in max_m: measured %.3f, claimed %.3f%s\n", measured_slope, claimed_slope, slow ? "  too slow" : "");
+	std::printf("  %s\n\n", ok ? "PASS" : "FAIL");
+	return ok;
+}
+
+int main(int argc, char* argv[]) {
+	const char* only = getOption(argc, argv, "cases");
+	double tolerance = std::atof(getOption(argc, argv, "tolerance", "0.15"));
+
+	int checked = 0, failed = 0;
+	for (const Case& c : CASES) {
+		if (only && ("," + std::string(only) + ",").find("," + std::string(c.generator) + ",") == std::string::npos) continue;
+		try {
+			if (!check(c, tolerance)) ++failed;
+		}
+		catch (const std::exception& e) {
+			std::printf("  error: %s\n  FAIL\n\n", e.what());
+			++failed;
+		}
+		++checked;
+	}
+	if (checked == 0) {
+		std::fprintf(stderr, "no case matches --cases=%s\n", only);
+		return 2;
+	}
+	std::printf("%d of %d cases passed\n", checked - failed, checked);
+	return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,46 @@
+/*
+ * Instance Format Converter
+ * Description: Converts an instance between the text "n m", DIMACS and
+ *   binary formats. The text format always uses 1 as source and n as
+ *   sink, so when writing it, the source and sink of other inputs are
+ *   swapped into those positions. Edge order is preserved.
+ * Usage: convert --format=text|dimacs|binary [input]
+ *   Reads the input file (or stdin), writes the instance to stdout.
+ */
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "../common/graph_writer.h"
+#include "../common/instance_reader.h"
+#include "../common/options.h"
+
+int main(int argc, char* argv[]) {
+	Format format = parseFormat(getOption(argc, argv, "format", "binary"));
+	InstanceReader in(getPositional(argc, argv));
+
+	std::vector<int> label(in.n);
+	std::iota(label.begin(), label.end(), 1);
+	if (format == Format::Text) {
+		std::swap(label[in.s], label[0]);
+		int last = std::find(label.begin(), label.end(), in.n) - label.begin();
+		std::swap(label[in.t], label[last]);
+	}
+
+	long long m = 0;
+	long long max_cap = 0;
+	in.readEdges([&](int, int, long long cap) {
+		m += 1;
+		max_cap = std::max(max_cap, cap);
+	});
+
+	GraphWriter out(format, in.n, m, label[in.s], label[in.t], max_cap);
+
+	// A negative capacity becomes 0: the binary format has no sign, and
+	// the solvers drop both alike.
+	in.readEdges([&](int from, int to, long long cap) {
+		out.edge(label[from], label[to], std::max(cap, 0LL));
+	});
+
+	return 0;
+}
@@ -0,0 +1,337 @@
+/*
+ * Differential Testing of the Solvers
+ * Description: Runs the same instances through every solver and checks
+ *   that they agree on the flow value. The instances are random graphs,
+ *   half small (at most 10 vertices) and half medium (at most 200), with
+ *   self-loops, parallel edges and zero capacities mixed in, and the
+ *   output of every generator. Random graphs are solved in this process;
+ *   a generator's instance may take exponential time for the solver it
+ *   targets, so each solver gets it in a forked child with a timeout, and
+ *   a solver that times out is left out of the comparison. A solver
+ *   disagrees if its value differs from the value most solvers found. Its
+ *   instance is then minimized: edges are removed in ever smaller chunks
+ *   and capacities lowered as long as the solver still disagrees with one
+ *   that found the majority value, and unused vertices are dropped. The
+ *   reproducer is written in DIMACS format.
+ *   Every solver's time is also recorded relative to the fastest solver
+ *   of the instance; the summary on stderr gives their geometric means.
+ * Usage: differential [options] > results.csv
+ *   --solvers=a,b,...     solvers to compare (default: all)
+ *   --random=K            random graphs (default: 1000)
+ *   --generators=a,b,...  generators (default: all)
+ *   --sizes=n:m,...       max_n:max_m of the generators (default: 40:120,200:600)
+ *   --max-cap=C           capacity bound of the generators (default: 1000000000)
+ *   --seed=S              seed of graphs, generators and solvers (default: 0)
+ *   --timeout=T           seconds per solver on a generator's instance (default: 10)
+ *   --reproducers=DIR     where reproducers go (default: .)
+ *   Writes a record per instance and solver with the fields instance, n,
+ *   m, solver, flow, seconds, relative (to the fastest) and status (ok,
+ *   mismatch, timeout or error). Exits with status 1 if any solver
+ *   disagreed or failed.
+ */
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../algorithms/registry.h"
+#include "../common/arena.h"
+#include "../common/forked_run.h"
+#include "../common/graph_writer.h"
+#include "../common/options.h"
+#include "../common/solver_sink.h"
+#include "../generators/registry.h"
+
+struct Instance {
+	struct Edge {
+		int from, to;
+		long long cap;
+	};
+
+	std::string name;
+	int n, s, t;
+	std::vector<Edge> edges;
+
+	void begin(long long _n, long long, int _s, int _t, long long) {
+		n = (int) _n;
+		s = _s - 1;
+		t = _t - 1;
+		edges.clear();
+	}
+
+	void edge(int from, int to, long long cap) {
+		edges.push_back({from - 1, to - 1, cap});
+	}
+
+	long long maxCap() const {
+		long long res = 0;
+		for (const Edge& e : edges) res = std::max(res, e.cap);
+		return res;
+	}
+
+	// Passes the instance to a sink like a generator does.
+	template<class Sink>
+	void generate(Sink& sink) const {
+		sink.begin(n, edges.size(), s + 1, t + 1, maxCap());
+		for (const Edge& e : edges) sink.edge(e.from + 1, e.to + 1, e.cap);
+	}
+};
+
+struct Outcome {
+	long long flow;
+	double seconds;
+	const char* status;
+};
+
+template<template<class> class Solver>
+long long solveWith(SolverTag<Solver>, const Instance& x, Arena& arena, uint64_t seed) {
+	return generateAndSolve<Solver>([&](auto& sink) { x.generate(sink); }, arena, [&](auto& g) { setSeed(g, seed); });
+}
+
+// Solves x in this process.
+Outcome solve(const Instance& x, const std::string& solver, uint64_t seed) {
+	Outcome res = {0, 0, "ok"};
+	Arena arena;
+	auto start = std::chrono::steady_clock::now();
+	try {
+		withSolver(solver, [&](auto tag) {
+			res.flow = solveWith(tag, x, arena, seed);
+		});
+	}
+	catch (const std::exception& e) {
+		std::fprintf(stderr, "%s on %s: %s\n", solver.c_str(), x.name.c_str(), e.what());
+		res.status = "error";
+	}
+	res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return res;
+}
+
+// Solves x in a forked child that is killed after timeout seconds.
+Outcome solveForked(const Instance& x, const std::string& solver, uint64_t seed, double timeout) {
+	ForkedRun child = runForked([&](int fd) {
+		Outcome r = solve(x, solver, seed);
+		if (std::strcmp(r.status, "ok") == 0) dprintf(fd, "%lld %.9f\n", r.flow, r.seconds);
+		return 0;
+	}, timeout);
+
+	Outcome res = {0, 0, child.status};
+	std::istringstream line(child.output);
+	if (std::strcmp(res.status, "timeout") != 0 && !(line >> res.flow >> res.seconds)) res.status = "error";
+	return res;
+}
+
+// True if solvers a and b still find different values on x.
+bool disagree(const Instance& x, const std::string& a, const std::string& b, uint64_t seed) {
+	Outcome ra = solve(x, a, seed), rb = solve(x, b, seed);
+	return std::strcmp(ra.status, "ok") == 0 && std::strcmp(rb.status, "ok") == 0 && ra.flow != rb.flow;
+}
+
+// Shrinks x while a and b keep disagreeing on it.
+Instance minimize(Instance x, const std::string& a, const std::string& b, uint64_t seed) {
+	// remove chunks of edges, halving the chunk size when none can go
+	for (size_t chunk = std::max<size_t>(x.edges.size() / 2, 1); chunk >= 1; chunk /= 2) {
+		bool removed = true;
+		while (removed) {
+			removed = false;
+			for (size_t begin = 0; begin < x.edges.size(); ) {
+				Instance y = x;
+				y.edges.erase(y.edges.begin() + begin, y.edges.begin() + std::min(begin + chunk, y.edges.size()));
+				if (disagree(y, a, b, seed)) {
+					x = y;
+					removed = true;
+				}
+				else begin += chunk;
+			}
+		}
+		if (chunk == 1) break;
+	}
+	// lower capacities: to 1 if possible, else by halving
+	for (Instance::Edge& e : x.edges) {
+		while (e.cap > 1) {
+			long long cap = e.cap;
+			e.cap = 1;
+			if (disagree(x, a, b, seed)) break;
+			e.cap = cap / 2;
+			if (disagree(x, a, b, seed)) continue;
+			e.cap = cap;
+			break;
+		}
+	}
+	// drop the vertices no edge uses
+	std::vector<int> label(x.n, -1);
+	Instance y = x;
+	y.n = 0;
+	label[x.s] = y.n++;
+	if (label[x.t] < 0) label[x.t] = y.n++;
+	for (Instance::Edge& e : y.edges) {
+		if (label[e.from] < 0) label[e.from] = y.n++;
+		if (label[e.to] < 0) label[e.to] = y.n++;
+		e.from = label[e.from];
+		e.to = label[e.to];
+	}
+	y.s = label[x.s];
+	y.t = label[x.t];
+	return disagree(y, a, b, seed) ? y : x;
+}
+
+void writeReproducer(const Instance& x, const std::string& path) {
+	int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) {
+		std::fprintf(stderr, "cannot write %s: %s\n", path.c_str(), std::strerror(errno));
+		return;
+	}
+	{
+		GraphWriter out(Format::Dimacs, x.n, x.edges.size(), x.s + 1, x.t + 1, x.maxCap(), 1, fd);
+		for (const Instance::Edge& e : x.edges) out.edge(e.from + 1, e.to + 1, e.cap);
+	}
+	close(fd);
+}
+
+Instance randomInstance(int index, std::mt19937_64& rng) {
+	// The last bound needs the int64_t capacities of the solvers.
+	static const long long CAPS[] = {1, 10, 1000, 1000000000, 1000000000000};
+	Instance x;
+	bool small = index % 2 == 0;
+	x.name = std::string(small ? "random_small_" : "random_medium_") + std::to_string(index);
+	x.n = std::uniform_int_distribution<int>(2, small ? 10 : 200)(rng);
+	int m = std::uniform_int_distribution<int>(0, small ? 30 : 10 * x.n)(rng);
+	long long max_cap = CAPS[rng() % 5];
+	x.s = (int) (rng() % x.n);
+	x.t = (int) (rng() % (x.n - 1));
+	if (x.t >= x.s) x.t += 1;
+	std::uniform_int_distribution<int> vertex(0, x.n - 1);
+	std::uniform_int_distribution<long long> cap(0, max_cap);
+	for (int i = 0; i < m; ++i) {
+		int from = vertex(rng);
+		int to = vertex(rng);
+		x.edges.push_back({from, to, cap(rng)});
+	}
+	return x;
+}
+
+int main(int argc, char* argv[]) {
+	std::vector<std::string> generators, solvers;
+	for (const char* name : GENERATORS) generators.push_back(name);
+	for (const char* name : SOLVERS) solvers.push_back(name);
+	if (const char* list = getOption(argc, argv, "generators")) generators = split(list);
+	if (const char* list = getOption(argc, argv, "solvers")) solvers = split(list);
+
+	std::vector<std::pair<int, int>> sizes;
+	for (const std::string& size : split(getOption(argc, argv, "sizes", "40:120,200:600"))) {
+		int max_n, max_m;
+		if (std::sscanf(size.c_str(), "%d:%d", &max_n, &max_m) != 2) {
+			std::fprintf(stderr, "bad size %s, expected max_n:max_m\n", size.c_str());
+			return 2;
+		}
+		sizes.emplace_back(max_n, max_m);
+	}
+
+	int random = std::atoi(getOption(argc, argv, "random", "1000"));
+	int max_cap = std::atoi(getOption(argc, argv, "max-cap", "1000000000"));
+	uint64_t seed = std::strtoull(getOption(argc, argv, "seed", "0"), nullptr, 10);
+	double timeout = std::atof(getOption(argc, argv, "timeout", "10"));
+	std::string reproducers = getOption(argc, argv, "reproducers", ".");
+
+	for (const std::string& name : generators) {
+		if (!withGenerator(name, [](auto) {})) {
+			std::fprintf(stderr, "unknown generator %s\n", name.c_str());
+			return 2;
+		}
+	}
+	for (const std::string& name : solvers) {
+		if (!withSolver(name, [](auto) {})) {
+			std::fprintf(stderr, "unknown solver %s\n", name.c_str());
+			return 2;
+		}
+	}
+
+	std::printf("instance,n,m,solver,flow,seconds,relative,status\n");
+	std::map<std::string, std::vector<double>> relative;
+	int instances = 0, failures = 0;
+	std::mt19937_64 rng(seed);
+	auto check = [&](const Instance& x, bool forked) {
+		instances += 1;
+		std::vector<Outcome> outcomes;
+		for (const std::string& solver : solvers) {
+			outcomes.push_back(forked ? solveForked(x, solver, seed, timeout) : solve(x, solver, seed));
+		}
+
+		std::map<long long, int> votes;
+		double fastest = INFINITY;
+		for (const Outcome& r : outcomes) {
+			if (std::strcmp(r.status, "ok") != 0) continue;
+			votes[r.flow] += 1;
+			fastest = std::min(fastest, r.seconds);
+		}
+		long long majority = 0;
+		int most = 0;
+		for (auto [flow, count] : votes) {
+			if (count > most) {
+				majority = flow;
+				most = count;
+			}
+		}
+		int agreeing = -1;
+		for (size_t i = 0; i < solvers.size(); ++i) {
+			if (std::strcmp(outcomes[i].status, "ok") == 0 && outcomes[i].flow == majority && agreeing < 0) agreeing = (int) i;
+		}
+
+		for (size_t i = 0; i < solvers.size(); ++i) {
+			Outcome& r = outcomes[i];
+			bool ok = std::strcmp(r.status, "ok") == 0;
+			if (ok && r.flow != majority) r.status = "mismatch";
+			if (std::strcmp(r.status, "timeout") != 0 && std::strcmp(r.status, "ok") != 0) failures += 1;
+			double ratio = fastest > 0 ? r.seconds / fastest : 1;
+			if (ok) {
+				relative[solvers[i]].push_back(ratio);
+				std::printf("%s,%d,%zu,%s,%lld,%.9f,%.3f,%s\n", x.name.c_str(), x.n, x.edges.size(), solvers[i].c_str(), r.flow, r.seconds, ratio, r.status);
+			}
+			else {
+				std::printf("%s,%d,%zu,%s,,,,%s\n", x.name.c_str(), x.n, x.edges.size(), solvers[i].c_str(), r.status);
+			}
+			std::fflush(stdout);
+			if (std::strcmp(r.status, "mismatch") == 0) {
+				Instance small = minimize(x, solvers[i], solvers[agreeing], seed);
+				std::string path = reproducers + "/" + x.name + "-" + solvers[i] + ".dimacs";
+				writeReproducer(small, path);
+				std::fprintf(stderr, "%s disagrees with %s on %s, reproducer with %d vertices and %zu edges: %s\n",
+					solvers[i].c_str(), solvers[agreeing].c_str(), x.name.c_str(), small.n, small.edges.size(), path.c_str());
+			}
+		}
+	};
+
+	for (int i = 0; i < random; ++i) {
+		check(randomInstance(i, rng), false);
+	}
+	for (const std::string& generator : generators) {
+		for (auto [max_n, max_m] : sizes) {
+			Instance x;
+			withGenerator(generator, [&](auto generate) { generate(max_n, max_m, max_cap, seed, x); });
+			x.name = generator + "-" + std::to_string(max_n) + "-" + std::to_string(max_m);
+			check(x, true);
+		}
+	}
+
+	std::fprintf(stderr, "%d instances, %d failures\n", instances, failures);
+	std::fprintf(stderr, "time relative to the fastest solver (geometric mean):\n");
+	for (const std::string& solver : solvers) {
+		double log_sum = 0;
+		for (double ratio : relative[solver]) log_sum += std::log(ratio);
+		size_t k = relative[solver].size();
+		std::fprintf(stderr, "  %-16s %8.3f\n", solver.c_str(), k ? std::exp(log_sum / k) : NAN);
+	}
+	return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,56 @@
+/*
+ * Instance Cache
+ * Description: Prints the path of a cached instance in the binary format
+ *   (see common/instance_cache.h), generating it first if needed. Large
+ *   instances are built once and can then be passed to every solver.
+ * Usage: instance_cache --generator=NAME --max-n=N --max-m=M
+ *     [--max-cap=C] [--seed=S] [--dir=DIR] [--threads=T]
+ *   max_cap defaults to 1000000000 as in the generator executables, seed
+ *   to 0, dir to the default cache directory. Example:
+ *     ./hlpp $(instance_cache --generator=gen_anti_hlpp --max-n=100000 --max-m=300000)
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+
+#include "../common/instance_cache.h"
+#include "../common/options.h"
+#include "../generators/registry.h"
+
+int main(int argc, char* argv[]) {
+	const char* generator = getOption(argc, argv, "generator");
+	const char* max_n = getOption(argc, argv, "max-n");
+	const char* max_m = getOption(argc, argv, "max-m");
+	if (!generator || !max_n || !max_m) {
+		std::fprintf(stderr, "usage: %s --generator=NAME --max-n=N --max-m=M [--max-cap=C] [--seed=S] [--dir=DIR] [--threads=T]\n", argv[0]);
+		return 2;
+	}
+
+	InstanceKey key;
+	key.generator = generator;
+	key.max_n = std::atoi(max_n);
+	key.max_m = std::atoi(max_m);
+	key.max_cap = std::atoi(getOption(argc, argv, "max-cap", "1000000000"));
+	key.seed = std::strtoull(getOption(argc, argv, "seed", "0"), nullptr, 10);
+	std::string dir = getOption(argc, argv, "dir", cacheDirectory().c_str());
+	int threads = std::atoi(getOption(argc, argv, "threads", "1"));
+
+	try {
+		std::string path;
+		bool found = withGenerator(key.generator, [&](auto generate) {
+			path = cachedInstance(dir, key, [&](auto& sink) {
+				generate(key.max_n, key.max_m, key.max_cap, key.seed, sink);
+			}, threads);
+		});
+		if (!found) {
+			std::fprintf(stderr, "unknown generator %s\n", generator);
+			return 2;
+		}
+		std::printf("%s\n", path.c_str());
+	}
+	catch (const std::exception& e) {
+		std::fprintf(stderr, "%s\n", e.what());
+		return 1;
+	}
+	return 0;
+}
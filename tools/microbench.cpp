@@ -0,0 +1,308 @@
+/*
+ * Microbenchmarks of Solver Primitives
+ * Description: Times single kernels of the solvers in isolation, so a
+ *   change of layout or of an inner loop can be judged in minutes instead
+ *   of by end-to-end runs. Every benchmark generates its instance once,
+ *   builds the solver's residual graph and brings it into the state the
+ *   kernel runs in, then calls the kernel over and over:
+ *     add_edge        addEdge for every edge of the instance and build(),
+ *                     which buffers the edges
+ *     two_pass        startCount, addEdge for every edge, startFill,
+ *                     addEdge again and build(), as runSolver builds the
+ *                     graph
+ *     dinic_bfs       Dinic::bfs, one level graph
+ *     dinic_dfs       Dinic::dfs from t, one blocking flow in the first
+ *                     level graph; the capacities are restored untimed
+ *                     before every call
+ *     global_relabel  HLPPHeuristic::globalRelabel after the initial pushes
+ *     relabel         HLPP::relabel of every vertex after preprocessing;
+ *                     every height is put back right after its relabel
+ *     dijkstra        MostImprovingAugmentingPaths::dijkstra, one search
+ *   A sample repeats the kernel until it has run for at least --min-time
+ *   seconds and yields the mean time per call; the first sample is a
+ *   warmup. Samples are summarized by their median and median absolute
+ *   deviation (see common/statistics.h), which outliers barely move.
+ * Usage: microbench [options] > micro.csv
+ *   --benchmarks=a,b,...  benchmarks to run (default: all)
+ *   --generator=NAME      instance of every benchmark (default: genrmf for
+ *                         add_edge and two_pass, otherwise the generator
+ *                         aimed at the kernel's solver)
+ *   --max-n=N, --max-m=M  instance size (default: 10000, 30000)
+ *   --max-cap=C           capacity bound (default: 1000000000)
+ *   --seed=S              generator seed (default: 0)
+ *   --samples=K           recorded samples (default: 21)
+ *   --min-time=T          seconds per sample (default: 0.01)
+ *   Writes one record per benchmark with the fields benchmark, generator,
+ *   n, m, arcs, samples, calls (per sample), median_ns and mad_ns (per
+ *   call), unit, units (per call) and ns_per_unit, where the unit is an
+ *   input edge for add_edge and two_pass and a residual arc for the others.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../algorithms/dinic.h"
+#include "../algorithms/hlpp.h"
+#include "../algorithms/hlpp_heuristic.h"
+#include "../algorithms/most_improving.h"
+#include "../common/arena.h"
+#include "../common/options.h"
+#include "../common/statistics.h"
+#include "../generators/registry.h"
+
+struct Config {
+	int max_n, max_m, max_cap;
+	uint64_t seed;
+	int samples;
+	double min_time;
+};
+
+struct Instance {
+	struct Edge {
+		int from, to;
+		long long cap;
+	};
+
+	int n, s, t;
+	long long max_cap;
+	std::vector<Edge> edges;
+
+	void begin(long long _n, long long, int _s, int _t, long long _max_cap) {
+		n = (int) _n;
+		s = _s - 1;
+		t = _t - 1;
+		max_cap = _max_cap;
+		edges.clear();
+	}
+
+	void edge(int from, int to, long long cap) {
+		edges.push_back({from - 1, to - 1, cap});
+	}
+
+	template<class Solver>
+	void fill(Solver& g) const {
+		for (const Edge& e : edges) g.addEdge(e.from, e.to, e.cap);
+		g.adj.build();
+	}
+
+	// Builds g the way runSolver does, without buffering the edges.
+	template<class Solver>
+	void fillTwoPass(Solver& g) const {
+		g.adj.startCount();
+		for (const Edge& e : edges) g.addEdge(e.from, e.to, e.cap);
+		g.adj.startFill();
+		for (const Edge& e : edges) g.addEdge(e.from, e.to, e.cap);
+		g.adj.build();
+	}
+};
+
+struct Result {
+	std::vector<double> seconds;
+	long long calls;
+	long long arcs;
+	double units;
+};
+
+// Calls prepare() untimed and run() timed until a sample has taken
+// min_time, for the warmup sample and every recorded one.
+template<class Prepare, class Run>
+void measure(const Config& config, Prepare&& prepare, Run&& run, Result& result) {
+	using Clock = std::chrono::steady_clock;
+	result.seconds.clear();
+	for (int sample = -1; sample < config.samples; ++sample) {
+		Clock::duration total = Clock::duration::zero();
+		long long calls = 0;
+		while (std::chrono::duration<double>(total).count() < config.min_time) {
+			prepare();
+			Clock::time_point start = Clock::now();
+			run();
+			total += Clock::now() - start;
+			calls += 1;
+		}
+		if (sample < 0) continue;
+		result.seconds.push_back(std::chrono::duration<double>(total).count() / calls);
+		result.calls = calls;
+	}
+}
+
+template<class Cap>
+void benchAddEdge(const Instance& x, const Config& config, Result& result) {
+	Arena arena;
+	measure(config, [&] { arena.reset(); }, [&] {
+		Dinic<Cap> g(x.n, x.s, x.t, arena);
+		x.fill(g);
+		result.arcs = g.adj.num_arcs;
+	}, result);
+	result.units = (double) x.edges.size();
+}
+
+template<class Cap>
+void benchTwoPass(const Instance& x, const Config& config, Result& result) {
+	Arena arena;
+	measure(config, [&] { arena.reset(); }, [&] {
+		Dinic<Cap> g(x.n, x.s, x.t, arena);
+		x.fillTwoPass(g);
+		result.arcs = g.adj.num_arcs;
+	}, result);
+	result.units = (double) x.edges.size();
+}
+
+template<class Cap>
+void benchDinicBfs(const Instance& x, const Config& config, Result& result) {
+	Arena arena;
+	Dinic<Cap> g(x.n, x.s, x.t, arena);
+	x.fill(g);
+	measure(config, [] {}, [&] { g.bfs(); }, result);
+	result.arcs = result.units = g.adj.num_arcs;
+}
+
+template<class Cap>
+void benchDinicDfs(const Instance& x, const Config& config, Result& result) {
+	Arena arena;
+	Dinic<Cap> g(x.n, x.s, x.t, arena);
+	x.fill(g);
+	if (!g.bfs()) throw std::runtime_error("t is not reachable from s");
+	std::vector<Arc<Cap>> arcs(g.adj.arcs, g.adj.arcs + g.adj.num_arcs);
+	std::vector<int> label(g.label, g.label + x.n);
+	measure(config, [&] {
+		std::copy(arcs.begin(), arcs.end(), g.adj.arcs);
+		std::copy(label.begin(), label.end(), g.label);
+		std::copy(g.adj.first, g.adj.first + x.n, g.iter);
+	}, [&] { g.dfs(x.t, std::numeric_limits<long long>::max()); }, result);
+	result.arcs = result.units = g.adj.num_arcs;
+}
+
+template<class Cap>
+void benchGlobalRelabel(const Instance& x, const Config& config, Result& result) {
+	Arena arena;
+	HLPPHeuristic<Cap> g(x.n, x.s, x.t, arena);
+	x.fill(g);
+	g.preprocess();
+	measure(config, [] {}, [&] { g.globalRelabel(); }, result);
+	result.arcs = result.units = g.adj.num_arcs;
+}
+
+template<class Cap>
+void benchRelabel(const Instance& x, const Config& config, Result& result) {
+	Arena arena;
+	HLPP<Cap> g(x.n, x.s, x.t, arena);
+	x.fill(g);
+	g.preprocess();
+	measure(config, [] {}, [&] {
+		for (int v = 0; v < x.n; ++v) {
+			if (v == x.s || v == x.t) continue;
+			int height = g.height[v];
+			g.relabel(v);
+			g.height[v] = height;
+		}
+	}, result);
+	result.arcs = g.adj.num_arcs;
+	int* first = g.adj.first;
+	result.units = g.adj.num_arcs - (first[x.s + 1] - first[x.s]) - (first[x.t + 1] - first[x.t]);
+}
+
+template<class Cap>
+void benchDijkstra(const Instance& x, const Config& config, Result& result) {
+	Arena arena;
+	MostImprovingAugmentingPaths<Cap> g(x.n, x.s, x.t, arena);
+	x.fill(g);
+	// as in flow(): every arc is relaxed at most once per search
+	g.heap = arena.allocate<std::pair<Cap, int>>(g.adj.num_arcs + 1, Use::Queues);
+	measure(config, [] {}, [&] { g.dijkstra(); }, result);
+	result.arcs = result.units = g.adj.num_arcs;
+}
+
+struct Benchmark {
+	const char* name;
+	const char* generator;
+	const char* unit;
+	void (*run[4])(const Instance&, const Config&, Result&);
+};
+
+#define CAPS(bench) {bench<uint8_t>, bench<uint16_t>, bench<int32_t>, bench<int64_t>}
+
+const Benchmark BENCHMARKS[] = {
+	{"add_edge", "genrmf", "edge", CAPS(benchAddEdge)},
+	{"two_pass", "genrmf", "edge", CAPS(benchTwoPass)},
+	{"dinic_bfs", "gen_anti_shortest_paths", "arc", CAPS(benchDinicBfs)},
+	{"dinic_dfs", "gen_anti_shortest_paths", "arc", CAPS(benchDinicDfs)},
+	{"global_relabel", "gen_anti_hipr", "arc", CAPS(benchGlobalRelabel)},
+	{"relabel", "gen_anti_hlpp", "arc", CAPS(benchRelabel)},
+	{"dijkstra", "gen_anti_most_improving", "arc", CAPS(benchDijkstra)},
+};
+
+#undef CAPS
+
+// Index of the narrowest capacity type that holds max_cap, in the order
+// uint8_t, uint16_t, int32_t, int64_t (as chosen by runSolver).
+int capacityType(long long max_cap) {
+	if (max_cap <= std::numeric_limits<uint8_t>::max()) return 0;
+	if (max_cap <= std::numeric_limits<uint16_t>::max()) return 1;
+	if (max_cap <= std::numeric_limits<int32_t>::max()) return 2;
+	return 3;
+}
+
+int main(int argc, char* argv[]) {
+	Config config;
+	config.max_n = std::atoi(getOption(argc, argv, "max-n", "10000"));
+	config.max_m = std::atoi(getOption(argc, argv, "max-m", "30000"));
+	config.max_cap = std::atoi(getOption(argc, argv, "max-cap", "1000000000"));
+	config.seed = std::strtoull(getOption(argc, argv, "seed", "0"), nullptr, 10);
+	config.samples = std::atoi(getOption(argc, argv, "samples", "21"));
+	config.min_time = std::atof(getOption(argc, argv, "min-time", "0.01"));
+	const char* generator = getOption(argc, argv, "generator");
+
+	std::vector<const Benchmark*> selected;
+	if (const char* list = getOption(argc, argv, "benchmarks")) {
+		for (const std::string& name : split(list)) {
+			const Benchmark* found = nullptr;
+			for (const Benchmark& b : BENCHMARKS) {
+				if (name == b.name) found = &b;
+			}
+			if (!found) {
+				std::fprintf(stderr, "unknown benchmark %s\n", name.c_str());
+				return 2;
+			}
+			selected.push_back(found);
+		}
+	}
+	else {
+		for (const Benchmark& b : BENCHMARKS) selected.push_back(&b);
+	}
+	if (generator && !withGenerator(generator, [](auto) {})) {
+		std::fprintf(stderr, "unknown generator %s\n", generator);
+		return 2;
+	}
+
+	std::printf("benchmark,generator,n,m,arcs,samples,calls,median_ns,mad_ns,unit,units,ns_per_unit\n");
+	int status = 0;
+	for (const Benchmark* b : selected) {
+		const char* name = generator ? generator : b->generator;
+		try {
+			Instance x;
+			withGenerator(name, [&](auto generate) {
+				generate(config.max_n, config.max_m, config.max_cap, config.seed, x);
+			});
+			Result result;
+			b->run[capacityType(x.max_cap)](x, config, result);
+			double ns = median(result.seconds) * 1e9;
+			std::printf("%s,%s,%d,%zu,%lld,%d,%lld,%.1f,%.1f,%s,%.0f,%.4f\n", b->name, name, x.n, x.edges.size(), result.arcs,
+				config.samples, result.calls, ns, medianAbsoluteDeviation(result.seconds) * 1e9, b->unit, result.units,
+				result.units > 0 ? ns / result.units : 0);
+			std::fflush(stdout);
+		}
+		catch (const std::exception& e) {
+			std::fprintf(stderr, "%s on %s: %s\n", b->name, name, e.what());
+			status = 1;
+		}
+	}
+	return status;
+}